@@ -5,6 +5,47 @@
 #include <iostream>
 #include <algorithm>
 
+// Identificadores densos de los actuadores del invernadero
+enum IdActuador {
+    ACT_VENTILADOR,
+    ACT_CALEFACTOR,
+    ACT_RIEGO,
+    ACT_LUZ_LED,
+    ACT_NEBULIZADOR,
+    NUM_ACTUADORES
+};
+
+inline const char* nombreActuador(int actuador) {
+    static const char* const nombres[NUM_ACTUADORES] = {
+        "VENTILADOR", "CALEFACTOR", "RIEGO", "LUZ_LED", "NEBULIZADOR"
+    };
+    return actuador >= 0 && actuador < NUM_ACTUADORES ? nombres[actuador] : "?";
+}
+
+// Potencia nominal de cada actuador al 100% en kW (estimada para costo energ�tico)
+inline double potenciaActuador(int actuador) {
+    static const double potencias[NUM_ACTUADORES] = { 0.15, 2.0, 0.4, 0.6, 0.3 };
+    return actuador >= 0 && actuador < NUM_ACTUADORES ? potencias[actuador] : 0.0;
+}
+
+// Id de un actuador por nombre; -1 si no existe - O(A)
+inline int buscarActuador(const std::string& nombre) {
+    for (int i = 0; i < NUM_ACTUADORES; i++) {
+        if (nombre == nombreActuador(i)) return i;
+    }
+    return -1;
+}
+
+// Orden de comando para un actuador; sin strings para poder viajar entre
+// hilos por una cola sin reservar memoria
+struct ComandoActuador {
+    IdActuador actuador;
+    double intensidad;
+
+    ComandoActuador() : actuador(ACT_VENTILADOR), intensidad(0.0) {}
+    ComandoActuador(IdActuador act, double inten) : actuador(act), intensidad(inten) {}
+};
+
 // Clase base abstracta para actuadores
 class Actuador {
 protected:
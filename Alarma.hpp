@@ -25,15 +25,16 @@ public:
     }
 
     // Operadores para comparaci�n en heap (menor prioridad = mayor urgencia)
+    // El min-heap extrae primero la alarma "menor": la de numero de prioridad mas bajo
     bool operator<(const Alarma& otra) const {
         if (prioridad != otra.prioridad)
-            return prioridad > otra.prioridad; // Invertido para min-heap
+            return prioridad < otra.prioridad;
         return timestamp > otra.timestamp;
     }
 
     bool operator>(const Alarma& otra) const {
         if (prioridad != otra.prioridad)
-            return prioridad < otra.prioridad;
+            return prioridad > otra.prioridad;
         return timestamp < otra.timestamp;
     }
 
@@ -2,15 +2,51 @@
 #define ARBOL_AVL_HPP
 
 #include "Nodo.hpp"
+#include "AsignadorNodos.hpp"
 #include <algorithm>
+#include <cmath>
 #include <vector>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Agregado de un rango del AVL sin materializar sus elementos
+struct ResumenRango {
+    int cantidad;
+    double suma;
+    double sumaCuadrados;
+    double minimo;
+    double maximo;
+
+    ResumenRango() : cantidad(0), suma(0.0), sumaCuadrados(0.0), minimo(0.0), maximo(0.0) {}
+
+    void agregar(int n, double s, double s2, double mn, double mx) {
+        if (n == 0) return;
+        minimo = (cantidad == 0) ? mn : std::min(minimo, mn);
+        maximo = (cantidad == 0) ? mx : std::max(maximo, mx);
+        cantidad += n;
+        suma += s;
+        sumaCuadrados += s2;
+    }
+
+    double promedio() const {
+        return cantidad ? suma / cantidad : 0.0;
+    }
+
+    // Desviacion estandar muestral
+    double desviacion() const {
+        if (cantidad < 2) return 0.0;
+        double varianza = (sumaCuadrados - suma * suma / cantidad) / (cantidad - 1);
+        return varianza > 0.0 ? std::sqrt(varianza) : 0.0;
+    }
+};
 
-template <typename T>
+template <typename T, template <typename> class Asignador = AsignadorNew>
 class ArbolAVL {
 private:
     NodoAVL<T>* raiz;
     int tamano;
+    Asignador<NodoAVL<T>> asignador;
 
     // Obtener altura del nodo - O(1)
     int altura(NodoAVL<T>* nodo) const {
@@ -22,13 +58,34 @@ private:
         return nodo ? altura(nodo->izquierdo) - altura(nodo->derecho) : 0;
     }
 
-    // Actualizar altura del nodo - O(1)
-    void actualizarAltura(NodoAVL<T>* nodo) {
+    // Actualizar altura y agregados del nodo a partir de sus hijos - O(1)
+    void actualizarNodo(NodoAVL<T>* nodo) {
         if (nodo) {
             nodo->altura = 1 + std::max(altura(nodo->izquierdo), altura(nodo->derecho));
+
+            double v = ValorAgregado<T>::obtener(nodo->dato);
+            nodo->tamanoSubarbol = 1;
+            nodo->suma = v;
+            nodo->sumaCuadrados = v * v;
+            nodo->minimo = nodo->maximo = v;
+            NodoAVL<T>* hijos[2] = { nodo->izquierdo, nodo->derecho };
+            for (NodoAVL<T>* hijo : hijos) {
+                if (hijo) {
+                    nodo->tamanoSubarbol += hijo->tamanoSubarbol;
+                    nodo->suma += hijo->suma;
+                    nodo->sumaCuadrados += hijo->sumaCuadrados;
+                    nodo->minimo = std::min(nodo->minimo, hijo->minimo);
+                    nodo->maximo = std::max(nodo->maximo, hijo->maximo);
+                }
+            }
         }
     }
 
+    // Tamano de subarbol - O(1)
+    int tamanoDe(NodoAVL<T>* nodo) const {
+        return nodo ? nodo->tamanoSubarbol : 0;
+    }
+
     // Rotaci�n simple a la derecha - O(1)
     NodoAVL<T>* rotarDerecha(NodoAVL<T>* y) {
         NodoAVL<T>* x = y->izquierdo;
@@ -37,8 +94,8 @@ private:
         x->derecho = y;
         y->izquierdo = T2;
 
-        actualizarAltura(y);
-        actualizarAltura(x);
+        actualizarNodo(y);
+        actualizarNodo(x);
 
         return x;
     }
@@ -51,15 +108,15 @@ private:
         y->izquierdo = x;
         x->derecho = T2;
 
-        actualizarAltura(x);
-        actualizarAltura(y);
+        actualizarNodo(x);
+        actualizarNodo(y);
 
         return y;
     }
 
     // Balancear nodo despu�s de inserci�n/eliminaci�n - O(1)
     NodoAVL<T>* balancear(NodoAVL<T>* nodo) {
-        actualizarAltura(nodo);
+        actualizarNodo(nodo);
         int balance = factorBalance(nodo);
 
         // Caso Izquierda-Izquierda
@@ -87,30 +144,58 @@ private:
         return nodo;
     }
 
-    // Insertar recursivo - O(log n)
-    NodoAVL<T>* insertarRec(NodoAVL<T>* nodo, T dato) {
-        if (!nodo) {
-            tamano++;
-            return new NodoAVL<T>(dato);
+    // Profundidad maxima del camino raiz-hoja (altura AVL <= 1.44 log2 n)
+    static const int ALTURA_MAXIMA = 64;
+
+    // Rebalancear de abajo hacia arriba los enlaces del camino recorrido - O(log n)
+    // Cada entrada apunta al enlace (raiz o hijo del padre) que sostiene al nodo.
+    void rebalancearCamino(NodoAVL<T>** camino[], int profundidad) {
+        for (int i = profundidad - 1; i >= 0; i--) {
+            *camino[i] = balancear(*camino[i]);
         }
+    }
 
-        if (dato < nodo->dato) {
-            nodo->izquierdo = insertarRec(nodo->izquierdo, dato);
-        } else if (dato > nodo->dato) {
-            nodo->derecho = insertarRec(nodo->derecho, dato);
-        } else {
-            return nodo; // No insertar duplicados
+    // Equivalencia usando solo operator<
+    static bool equivalentes(const T& a, const T& b) {
+        return !(a < b) && !(b < a);
+    }
+
+    // Primer nodo con dato >= valor, o nullptr - O(log n)
+    NodoAVL<T>* buscarPrimeroNoMenor(const T& valor) const {
+        NodoAVL<T>* actual = raiz;
+        NodoAVL<T>* candidato = nullptr;
+        while (actual) {
+            if (actual->dato < valor) {
+                actual = actual->derecho;
+            } else {
+                candidato = actual;
+                actual = actual->izquierdo;
+            }
         }
+        return candidato;
+    }
 
-        return balancear(nodo);
+    void agregarDato(ResumenRango& resumen, const T& dato) const {
+        double v = ValorAgregado<T>::obtener(dato);
+        resumen.agregar(1, v, v * v, v, v);
     }
 
-    // Buscar recursivo - O(log n)
-    bool buscarRec(NodoAVL<T>* nodo, T dato) const {
-        if (!nodo) return false;
-        if (dato == nodo->dato) return true;
-        if (dato < nodo->dato) return buscarRec(nodo->izquierdo, dato);
-        return buscarRec(nodo->derecho, dato);
+    void agregarSubarbol(ResumenRango& resumen, NodoAVL<T>* nodo) const {
+        if (nodo) {
+            resumen.agregar(nodo->tamanoSubarbol, nodo->suma, nodo->sumaCuadrados,
+                            nodo->minimo, nodo->maximo);
+        }
+    }
+
+    // Construir subarbol balanceado desde datos[inicio..fin) ordenados - O(n)
+    NodoAVL<T>* construirRec(const std::vector<T>& datos, int inicio, int fin) {
+        if (inicio >= fin) return nullptr;
+        int medio = inicio + (fin - inicio) / 2;
+        NodoAVL<T>* nodo = asignador.crear(datos[medio]);
+        nodo->izquierdo = construirRec(datos, inicio, medio);
+        nodo->derecho = construirRec(datos, medio + 1, fin);
+        actualizarNodo(nodo);
+        return nodo;
     }
 
     // Recorrido inorden recursivo - O(n)
@@ -123,14 +208,14 @@ private:
     }
 
     // Buscar en rango - O(log n + k) donde k = elementos en rango
-    void buscarRangoRec(NodoAVL<T>* nodo, T min, T max, std::vector<T>& resultado) const {
+    void buscarRangoRec(NodoAVL<T>* nodo, const T& min, const T& max, std::vector<T>& resultado) const {
         if (!nodo) return;
 
         if (min < nodo->dato) {
             buscarRangoRec(nodo->izquierdo, min, max, resultado);
         }
 
-        if (min <= nodo->dato && nodo->dato <= max) {
+        if (!(nodo->dato < min) && !(max < nodo->dato)) {
             resultado.push_back(nodo->dato);
         }
 
@@ -139,12 +224,26 @@ private:
         }
     }
 
+    template <typename Func>
+    void recorrerRangoRec(NodoAVL<T>* nodo, const T& min, const T& max, Func& funcion) const {
+        if (!nodo) return;
+        if (min < nodo->dato) {
+            recorrerRangoRec(nodo->izquierdo, min, max, funcion);
+        }
+        if (!(nodo->dato < min) && !(max < nodo->dato)) {
+            funcion(nodo->dato);
+        }
+        if (nodo->dato < max) {
+            recorrerRangoRec(nodo->derecho, min, max, funcion);
+        }
+    }
+
     // Liberar memoria recursivo
     void liberarRec(NodoAVL<T>* nodo) {
         if (nodo) {
             liberarRec(nodo->izquierdo);
             liberarRec(nodo->derecho);
-            delete nodo;
+            asignador.destruir(nodo);
         }
     }
 
@@ -152,17 +251,145 @@ public:
     ArbolAVL() : raiz(nullptr), tamano(0) {}
 
     ~ArbolAVL() {
-        liberarRec(raiz);
+        limpiar();
+    }
+
+    // Insertar elemento (iterativo) - O(log n)
+    // Retorna false si ya existia un elemento equivalente
+    bool insertar(const T& dato) {
+        NodoAVL<T>** camino[ALTURA_MAXIMA];
+        int profundidad = 0;
+        NodoAVL<T>** enlace = &raiz;
+
+        while (*enlace) {
+            NodoAVL<T>* nodo = *enlace;
+            if (dato < nodo->dato) {
+                camino[profundidad++] = enlace;
+                enlace = &nodo->izquierdo;
+            } else if (nodo->dato < dato) {
+                camino[profundidad++] = enlace;
+                enlace = &nodo->derecho;
+            } else {
+                return false; // No insertar duplicados
+            }
+        }
+
+        *enlace = asignador.crear(dato);
+        tamano++;
+        rebalancearCamino(camino, profundidad);
+        return true;
+    }
+
+    // Eliminar elemento (iterativo) - O(log n)
+    bool eliminar(const T& dato) {
+        NodoAVL<T>** camino[ALTURA_MAXIMA];
+        int profundidad = 0;
+        NodoAVL<T>** enlace = &raiz;
+
+        while (*enlace && !equivalentes(dato, (*enlace)->dato)) {
+            camino[profundidad++] = enlace;
+            enlace = (dato < (*enlace)->dato) ? &(*enlace)->izquierdo : &(*enlace)->derecho;
+        }
+        if (!*enlace) return false;
+
+        NodoAVL<T>* objetivo = *enlace;
+        if (objetivo->izquierdo && objetivo->derecho) {
+            // Dos hijos: reemplazar por el sucesor (minimo del subarbol derecho)
+            camino[profundidad++] = enlace;
+            enlace = &objetivo->derecho;
+            while ((*enlace)->izquierdo) {
+                camino[profundidad++] = enlace;
+                enlace = &(*enlace)->izquierdo;
+            }
+            NodoAVL<T>* sucesor = *enlace;
+            objetivo->dato = std::move(sucesor->dato);
+            *enlace = sucesor->derecho;
+            asignador.destruir(sucesor);
+        } else {
+            *enlace = objetivo->izquierdo ? objetivo->izquierdo : objetivo->derecho;
+            asignador.destruir(objetivo);
+        }
+
+        tamano--;
+        rebalancearCamino(camino, profundidad);
+        return true;
+    }
+
+    // Eliminar todos los elementos en [min, max] - O(k log n), o O(n) si k es grande
+    // Pensado para retencion por tiempo: eliminarRango(inicioDeLosTiempos, limite)
+    int eliminarRango(const T& min, const T& max) {
+        if (max < min) return 0;
+
+        int eliminados = 0;
+        int limiteIndividual = tamano / 4;
+        NodoAVL<T>* nodo = buscarPrimeroNoMenor(min);
+        while (nodo && !(max < nodo->dato) && eliminados < limiteIndividual) {
+            T dato = nodo->dato;
+            eliminar(dato);
+            eliminados++;
+            nodo = buscarPrimeroNoMenor(min);
+        }
+
+        // Si el rango cubre buena parte del arbol es mas barato reconstruirlo
+        if (nodo && !(max < nodo->dato)) {
+            std::vector<T> restantes;
+            restantes.reserve(tamano);
+            std::vector<T> todos = inorden();
+            for (const T& dato : todos) {
+                if (dato < min || max < dato) {
+                    restantes.push_back(dato);
+                } else {
+                    eliminados++;
+                }
+            }
+            construirDesdeOrdenado(restantes);
+        }
+        return eliminados;
     }
 
-    // Insertar elemento - O(log n)
-    void insertar(T dato) {
-        raiz = insertarRec(raiz, dato);
+    // Reemplazar el contenido con datos ordenados ascendentemente - O(n)
+    // Los elementos equivalentes consecutivos se descartan como en insertar()
+    void construirDesdeOrdenado(const std::vector<T>& ordenados) {
+        bool hayDuplicados = false;
+        for (size_t i = 1; i < ordenados.size(); i++) {
+            if (ordenados[i] < ordenados[i - 1]) {
+                throw std::invalid_argument("Datos no ordenados");
+            }
+            if (!(ordenados[i - 1] < ordenados[i])) {
+                hayDuplicados = true;
+            }
+        }
+
+        limpiar();
+        if (hayDuplicados) {
+            std::vector<T> unicos;
+            unicos.reserve(ordenados.size());
+            for (const T& dato : ordenados) {
+                if (unicos.empty() || unicos.back() < dato) {
+                    unicos.push_back(dato);
+                }
+            }
+            raiz = construirRec(unicos, 0, unicos.size());
+            tamano = unicos.size();
+        } else {
+            raiz = construirRec(ordenados, 0, ordenados.size());
+            tamano = ordenados.size();
+        }
     }
 
-    // Buscar elemento - O(log n)
-    bool buscar(T dato) const {
-        return buscarRec(raiz, dato);
+    // Buscar elemento (iterativo) - O(log n)
+    bool buscar(const T& dato) const {
+        NodoAVL<T>* actual = raiz;
+        while (actual) {
+            if (dato < actual->dato) {
+                actual = actual->izquierdo;
+            } else if (actual->dato < dato) {
+                actual = actual->derecho;
+            } else {
+                return true;
+            }
+        }
+        return false;
     }
 
     // Obtener elementos en orden - O(n)
@@ -173,12 +400,128 @@ public:
     }
 
     // Buscar elementos en rango [min, max] - O(log n + k)
-    std::vector<T> buscarRango(T min, T max) const {
+    std::vector<T> buscarRango(const T& min, const T& max) const {
         std::vector<T> resultado;
         buscarRangoRec(raiz, min, max, resultado);
         return resultado;
     }
 
+    // Visitar en orden los elementos en [min, max] sin copiarlos - O(log n + k)
+    template <typename Func>
+    void recorrerRango(const T& min, const T& max, Func funcion) const {
+        recorrerRangoRec(raiz, min, max, funcion);
+    }
+
+    // Resumen de todo el arbol (agregados de la raiz) - O(1)
+    ResumenRango resumenTotal() const {
+        ResumenRango resumen;
+        agregarSubarbol(resumen, raiz);
+        return resumen;
+    }
+
+    // Cantidad de elementos menores que valor (rango) - O(log n)
+    int contarMenores(const T& valor) const {
+        int cuenta = 0;
+        NodoAVL<T>* actual = raiz;
+        while (actual) {
+            if (actual->dato < valor) {
+                cuenta += tamanoDe(actual->izquierdo) + 1;
+                actual = actual->derecho;
+            } else {
+                actual = actual->izquierdo;
+            }
+        }
+        return cuenta;
+    }
+
+    // Cantidad de elementos menores o equivalentes a valor - O(log n)
+    int contarNoMayores(const T& valor) const {
+        int cuenta = 0;
+        NodoAVL<T>* actual = raiz;
+        while (actual) {
+            if (valor < actual->dato) {
+                actual = actual->izquierdo;
+            } else {
+                cuenta += tamanoDe(actual->izquierdo) + 1;
+                actual = actual->derecho;
+            }
+        }
+        return cuenta;
+    }
+
+    // Cantidad de elementos en [min, max] sin recorrerlos - O(log n)
+    int contarRango(const T& min, const T& max) const {
+        if (max < min) return 0;
+        return contarNoMayores(max) - contarMenores(min);
+    }
+
+    // k-esimo elemento en orden (k desde 0) - O(log n)
+    const T& kEsimo(int k) const {
+        if (k < 0 || k >= tamano) {
+            throw std::out_of_range("Indice fuera de rango");
+        }
+        NodoAVL<T>* actual = raiz;
+        while (true) {
+            int izquierdos = tamanoDe(actual->izquierdo);
+            if (k < izquierdos) {
+                actual = actual->izquierdo;
+            } else if (k == izquierdos) {
+                return actual->dato;
+            } else {
+                k -= izquierdos + 1;
+                actual = actual->derecho;
+            }
+        }
+    }
+
+    // Elemento en el percentil p (0..1) del orden del arbol - O(log n)
+    const T& percentil(double p) const {
+        if (estaVacio()) {
+            throw std::runtime_error("Arbol vacio");
+        }
+        p = std::max(0.0, std::min(1.0, p));
+        return kEsimo((int)(p * (tamano - 1) + 0.5));
+    }
+
+    // Cantidad, suma, minimo y maximo de los valores en [min, max] - O(log n)
+    ResumenRango resumenRango(const T& min, const T& max) const {
+        ResumenRango resumen;
+        if (max < min) return resumen;
+
+        // Bajar hasta el nodo donde el rango se divide
+        NodoAVL<T>* division = raiz;
+        while (division) {
+            if (division->dato < min) division = division->derecho;
+            else if (max < division->dato) division = division->izquierdo;
+            else break;
+        }
+        if (!division) return resumen;
+        agregarDato(resumen, division->dato);
+
+        // Rama izquierda: todo lo que es >= min
+        for (NodoAVL<T>* actual = division->izquierdo; actual; ) {
+            if (actual->dato < min) {
+                actual = actual->derecho;
+            } else {
+                agregarDato(resumen, actual->dato);
+                agregarSubarbol(resumen, actual->derecho);
+                actual = actual->izquierdo;
+            }
+        }
+
+        // Rama derecha: todo lo que es <= max
+        for (NodoAVL<T>* actual = division->derecho; actual; ) {
+            if (max < actual->dato) {
+                actual = actual->izquierdo;
+            } else {
+                agregarDato(resumen, actual->dato);
+                agregarSubarbol(resumen, actual->izquierdo);
+                actual = actual->derecho;
+            }
+        }
+        return resumen;
+    }
+
     bool estaVacio() const {
         return raiz == nullptr;
     }
@@ -190,6 +533,22 @@ public:
     int getAltura() const {
         return altura(raiz);
     }
+
+    // Con una arena y T trivial se libera todo de golpe sin recorrer - O(1)
+    void limpiar() {
+        if (Asignador<NodoAVL<T>>::liberacionMasiva && std::is_trivially_destructible<T>::value) {
+            asignador.reiniciar();
+        } else {
+            liberarRec(raiz);
+            asignador.reiniciar();
+        }
+        raiz = nullptr;
+        tamano = 0;
+    }
+
+    const EstadisticasAsignador& getEstadisticasMemoria() const {
+        return asignador.getEstadisticas();
+    }
 };
 
 #endif
@@ -7,15 +7,28 @@
 #include <iostream>
 #include <cmath>
 #include <iomanip>
+#include <sstream>
+#include <queue>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include "Predicado.hpp"
+#include "Actuador.hpp"
 
 // Estructura para representar una acción de control
+// El nombre queda para mostrar y escribir; el ciclo de control usa idActuador,
+// que se resuelve al aplanar (NUM_ACTUADORES mientras no se resuelva).
 struct AccionControl {
     std::string actuador;
+    IdActuador idActuador;
     double intensidad;
     std::string razon;
     
     AccionControl(std::string act, double inten, std::string raz)
-        : actuador(act), intensidad(inten), razon(raz) {}
+        : actuador(act), idActuador(NUM_ACTUADORES), intensidad(inten), razon(raz) {}
+    
+    AccionControl(IdActuador id, double inten, std::string raz)
+        : actuador(nombreActuador(id)), idActuador(id), intensidad(inten), razon(raz) {}
 };
 
 // Nodo del árbol de decisión
@@ -23,6 +36,7 @@ class NodoDecision {
 public:
     std::string etiqueta;
     std::string condicion;
+    Predicado predicado;      // condicion compilada al construir el nodo
     std::vector<AccionControl> acciones;
     
     NodoDecision* izquierdo;  // Rama SI
@@ -33,7 +47,11 @@ public:
     
     NodoDecision(std::string etiq, std::string cond = "", int niv = 0)
         : etiqueta(etiq), condicion(cond), izquierdo(nullptr), 
-          derecho(nullptr), esHoja(false), nivel(niv) {}
+          derecho(nullptr), esHoja(false), nivel(niv) {
+        if (!condicion.empty()) {
+            predicado = Predicado::compilar(condicion);
+        }
+    }
     
     ~NodoDecision() {
         delete izquierdo;
@@ -46,86 +64,216 @@ public:
     }
 };
 
+// Nodo del árbol aplanado: 32 bytes, sin punteros
+// La condición se guarda como intervalo abierto (bajo, alto) sobre una
+// variable: "x>u" es (u, +inf), "x<u" es (-inf, u) y "x=u" es (u-0.1, u+0.1).
+// Una hoja tiene ambos hijos apuntando a sí misma, así que recorrer más
+// niveles de los necesarios no cambia el resultado.
+struct NodoPlano {
+    double bajo;
+    double alto;
+    uint16_t hijos[2];        // [0] rama SI, [1] rama NO
+    uint16_t primeraAccion;   // acciones de la hoja en accionesHojas
+    uint16_t numAcciones;
+    uint8_t variable;
+    uint8_t esHoja;
+};
+
+// Acciones de una hoja, sin copiarlas: vista sobre el arreglo del árbol
+// Válida hasta que el árbol se reconstruya.
+struct RangoAcciones {
+    const AccionControl* inicio;
+    const AccionControl* fin;
+    
+    const AccionControl* begin() const { return inicio; }
+    const AccionControl* end() const { return fin; }
+    size_t size() const { return fin - inicio; }
+    bool empty() const { return inicio == fin; }
+    const AccionControl& operator[](size_t i) const { return inicio[i]; }
+};
+
 // Árbol de decisión para control del invernadero
+// Se arma con NodoDecision y se guarda aplanado en anchura (BFS) en un
+// arreglo contiguo; las acciones de todas las hojas viven en otro arreglo.
 class ArbolDecision {
 private:
-    NodoDecision* raiz;
-    std::vector<std::string> caminoDecision;
-    std::vector<AccionControl> accionesFinales;
-    std::map<std::string, double> valoresSensores;
+    std::vector<NodoPlano> nodos;          // nodos[0] es la raíz
+    std::vector<std::string> etiquetas;    // por nodo, solo para mostrar
+    std::vector<std::string> condiciones;  // por nodo, solo para mostrar
+    std::vector<AccionControl> accionesHojas;
+    int profundidad;                       // aristas del camino más largo
+    int version;                           // versión del archivo; 0 = predefinido
     
-    // Evaluar condición
-    bool evaluarCondicion(std::string condicion, std::map<std::string, double>& sensores) {
-        size_t posOperador = condicion.find_first_of("<>=");
-        if (posOperador == std::string::npos) return false;
-        
-        std::string sensor = condicion.substr(0, posOperador);
-        sensor.erase(0, sensor.find_first_not_of(" \t"));
-        sensor.erase(sensor.find_last_not_of(" \t") + 1);
-        
-        char operador = condicion[posOperador];
-        double umbral = std::stod(condicion.substr(posOperador + 1));
+    // Traza opcional de la última decisión: nodos visitados y rama tomada
+    // (0 = SI, 1 = NO). Se reserva al aplanar, así que decidir no asigna memoria.
+    bool trazado;
+    std::vector<uint16_t> nodosCamino;
+    std::vector<uint8_t> ramasCamino;
+    ValoresControl valoresSensores;
+    uint16_t ultimaHoja;
+    
+    static const int TAMANO_GRUPO_LOTE = 8;
+    
+    // Evaluar la condición de un nodo: 0 = SI, 1 = NO (NaN da NO) - sin saltos
+    static int rama(const NodoPlano& nodo, const ValoresControl& sensores) {
+        double x = sensores[nodo.variable];
+        return !((x > nodo.bajo) & (x < nodo.alto));
+    }
+    
+    // Pasar el árbol de punteros al arreglo en anchura - O(n)
+    void aplanar(const NodoDecision* raiz) {
+        nodos.clear();
+        etiquetas.clear();
+        condiciones.clear();
+        accionesHojas.clear();
+        profundidad = 0;
         
-        if (sensores.find(sensor) == sensores.end()) return false;
+        const double infinito = std::numeric_limits<double>::infinity();
+        int hojaVacia = -1; // destino de las ramas sin hijo (sin acciones)
         
-        double valorSensor = sensores[sensor];
+        std::vector<const NodoDecision*> orden;
+        std::vector<int> niveles;
+        orden.push_back(raiz);
+        niveles.push_back(0);
+        // En anchura: los hijos se numeran en el orden en que se descubren
+        for (size_t i = 0; i < orden.size(); i++) {
+            const NodoDecision* actual = orden[i];
+            if (actual && !actual->esHoja) {
+                const NodoDecision* hijos[2] = {actual->izquierdo, actual->derecho};
+                for (const NodoDecision* hijo : hijos) {
+                    if (!hijo) continue;
+                    orden.push_back(hijo);
+                    niveles.push_back(niveles[i] + 1);
+                }
+            }
+        }
+        if (orden.size() + 1 > UINT16_MAX) {
+            throw std::length_error("Arbol demasiado grande");
+        }
         
-        switch(operador) {
-            case '>': return valorSensor > umbral;
-            case '<': return valorSensor < umbral;
-            case '=': return std::abs(valorSensor - umbral) < 0.1;
-            default: return false;
+        int numerado = 1;
+        for (size_t i = 0; i < orden.size(); i++) {
+            const NodoDecision* actual = orden[i];
+            NodoPlano plano;
+            plano.hijos[0] = plano.hijos[1] = (uint16_t)i;
+            plano.primeraAccion = (uint16_t)accionesHojas.size();
+            plano.numAcciones = 0;
+            plano.variable = 0;
+            plano.bajo = -infinito;
+            plano.alto = infinito;
+            plano.esHoja = actual->esHoja ? 1 : 0;
+            profundidad = std::max(profundidad, niveles[i]);
+            
+            if (actual->esHoja) {
+                for (const AccionControl& accion : actual->acciones) {
+                    accionesHojas.push_back(accion);
+                    AccionControl& copia = accionesHojas.back();
+                    if (copia.idActuador == NUM_ACTUADORES) {
+                        int id = buscarActuador(copia.actuador);
+                        if (id < 0) throw std::invalid_argument("Actuador desconocido: " + copia.actuador);
+                        copia.idActuador = (IdActuador)id;
+                    }
+                }
+                plano.numAcciones = (uint16_t)actual->acciones.size();
+            } else {
+                const Predicado& p = actual->predicado;
+                plano.variable = p.variable;
+                if (p.operador == '>') {
+                    plano.bajo = p.umbral;
+                } else if (p.operador == '<') {
+                    plano.alto = p.umbral;
+                } else {
+                    plano.bajo = p.umbral - 0.1;
+                    plano.alto = p.umbral + 0.1;
+                }
+                const NodoDecision* hijos[2] = {actual->izquierdo, actual->derecho};
+                for (int r = 0; r < 2; r++) {
+                    if (hijos[r]) {
+                        plano.hijos[r] = (uint16_t)numerado++;
+                    } else {
+                        if (hojaVacia < 0) hojaVacia = (int)orden.size();
+                        plano.hijos[r] = (uint16_t)hojaVacia;
+                        // La hoja vacía queda un nivel debajo de este nodo
+                        profundidad = std::max(profundidad, niveles[i] + 1);
+                    }
+                }
+            }
+            nodos.push_back(plano);
+            etiquetas.push_back(actual->etiqueta);
+            condiciones.push_back(actual->condicion);
         }
-    }
-    
-    // Recorrer árbol
-    void recorrerArbol(NodoDecision* nodo, std::map<std::string, double>& sensores) {
-        if (!nodo) return;
         
-        if (nodo == raiz) {
-            caminoDecision.push_back("RAIZ|" + nodo->condicion);
-        } else if (!nodo->esHoja) {
-            caminoDecision.push_back("DECISION|" + nodo->etiqueta + "|" + nodo->condicion);
-        } else {
-            caminoDecision.push_back("ACCION|" + nodo->etiqueta);
+        if (hojaVacia >= 0) {
+            NodoPlano vacia;
+            vacia.bajo = -infinito;
+            vacia.alto = infinito;
+            vacia.hijos[0] = vacia.hijos[1] = (uint16_t)hojaVacia;
+            vacia.primeraAccion = (uint16_t)accionesHojas.size();
+            vacia.numAcciones = 0;
+            vacia.variable = 0;
+            vacia.esHoja = 1;
+            nodos.push_back(vacia);
+            etiquetas.push_back("SIN ACCION");
+            condiciones.push_back("");
         }
         
-        if (nodo->esHoja) {
-            for (const auto& accion : nodo->acciones) {
-                accionesFinales.push_back(accion);
+        nodosCamino.reserve(profundidad + 1);
+        ramasCamino.reserve(profundidad + 1);
+        ultimaHoja = 0;
+        while (!nodos[ultimaHoja].esHoja) ultimaHoja = nodos[ultimaHoja].hijos[1];
+    }
+    
+    // Dibujar un nodo y sus ramas con sangría - O(n)
+    void mostrarSubarbol(uint16_t i, const std::string& prefijo) const {
+        const NodoPlano& nodo = nodos[i];
+        if (nodo.esHoja) {
+            std::cout << "[" << etiquetas[i] << "]";
+            for (const auto& accion : getAccionesHoja(i)) {
+                std::cout << " " << accion.actuador << ":" << (int)accion.intensidad << "%";
             }
+            std::cout << "\n";
             return;
         }
-        
-        bool resultado = evaluarCondicion(nodo->condicion, sensores);
-        
-        // Extraer sensor y valor
-        std::string sensorNombre = nodo->condicion.substr(0, nodo->condicion.find_first_of("<>="));
-        sensorNombre.erase(0, sensorNombre.find_first_not_of(" \t"));
-        sensorNombre.erase(sensorNombre.find_last_not_of(" \t") + 1);
-        double valorSensor = sensores[sensorNombre];
-        
-        if (resultado && nodo->izquierdo) {
-            caminoDecision.push_back("SI|" + sensorNombre + "|" + std::to_string((int)valorSensor) + "|" + nodo->condicion);
-            recorrerArbol(nodo->izquierdo, sensores);
-        } else if (!resultado && nodo->derecho) {
-            caminoDecision.push_back("NO|" + sensorNombre + "|" + std::to_string((int)valorSensor) + "|" + nodo->condicion);
-            recorrerArbol(nodo->derecho, sensores);
+        std::cout << "[" << etiquetas[i] << "] (" << condiciones[i] << "?)\n";
+        std::cout << prefijo << "+--SI--> ";
+        mostrarSubarbol(nodo.hijos[0], prefijo + "|        ");
+        std::cout << prefijo << "+--NO--> ";
+        mostrarSubarbol(nodo.hijos[1], prefijo + "         ");
+    }
+    
+    // Recorrer árbol desde la raíz hasta una hoja - O(profundidad)
+    uint16_t recorrerArbol(const ValoresControl& sensores) {
+        uint16_t i = 0;
+        while (!nodos[i].esHoja) {
+            int r = rama(nodos[i], sensores);
+            if (trazado) {
+                nodosCamino.push_back(i);
+                ramasCamino.push_back((uint8_t)r);
+            }
+            i = nodos[i].hijos[r];
+        }
+        if (trazado) {
+            nodosCamino.push_back(i);
+            ramasCamino.push_back(0);
         }
+        return i;
     }
 
 public:
-    ArbolDecision() {
+    ArbolDecision() : profundidad(0), version(0), trazado(false), ultimaHoja(0) {
         construirArbol();
     }
     
-    ~ArbolDecision() {
-        delete raiz;
+    // Armar desde un árbol de nodos ya validado (p. ej. leído de un archivo)
+    // Solo se copia al arreglo plano: los nodos siguen siendo del llamador.
+    ArbolDecision(const NodoDecision* raiz, int _version)
+        : profundidad(0), version(_version), trazado(false), ultimaHoja(0) {
+        aplanar(raiz);
     }
     
     // Construir árbol lógico
     void construirArbol() {
-        raiz = new NodoDecision("RAIZ", "TEMP>35", 0);
+        NodoDecision* raiz = new NodoDecision("RAIZ", "TEMP>35", 0);
         
         // SI: Temp > 35
         NodoDecision* enfriar = new NodoDecision("ENFRIAR MAXIMO", "", 1);
@@ -172,102 +320,163 @@ public:
                     mantener->agregarAccion("RIEGO", 30.0, "Mantener humedad");
                     mantener->agregarAccion("LUZ_LED", 60.0, "Iluminacion");
                     evalHumRel->derecho = mantener;
+        
+        aplanar(raiz);
+        delete raiz;
     }
     
-    // Tomar decisiones
-    std::vector<AccionControl> decidir(std::map<std::string, double> sensores) {
-        caminoDecision.clear();
-        accionesFinales.clear();
-        valoresSensores = sensores;
+    // Guardar o no el camino de cada decisión (para mostrarProcesoDecision)
+    void setTrazado(bool activo) { trazado = activo; }
+    bool getTrazado() const { return trazado; }
+    
+    // Tomar decisiones - O(profundidad), sin asignaciones
+    RangoAcciones decidir(const ValoresControl& sensores) {
+        nodosCamino.clear();
+        ramasCamino.clear();
+        if (trazado) valoresSensores = sensores;
         
-        recorrerArbol(raiz, sensores);
+        ultimaHoja = recorrerArbol(sensores);
         
-        return accionesFinales;
+        return getAccionesHoja(ultimaHoja);
     }
     
-    // Obtener camino de decisión
+    RangoAcciones decidir(const std::map<std::string, double>& sensores) {
+        return decidir(ValoresControl::desdeMapa(sensores));
+    }
+    
+    // Evaluar el árbol para n vectores de sensores y escribir en hojas[i] el
+    // nodo hoja alcanzado por entradas[i] - O(n * profundidad)
+    // Sin saltos por nodo: cada vector baja exactamente 'profundidad' niveles
+    // (las hojas apuntan a sí mismas) y se procesan de a grupos para que las
+    // cargas de nodos de vectores distintos se solapen.
+    void decidirLote(const ValoresControl* entradas, size_t n, uint16_t* hojas) const {
+        const NodoPlano* arbol = nodos.data();
+        size_t inicio = 0;
+        for (; inicio + TAMANO_GRUPO_LOTE <= n; inicio += TAMANO_GRUPO_LOTE) {
+            uint16_t actual[TAMANO_GRUPO_LOTE] = {0};
+            for (int nivel = 0; nivel < profundidad; nivel++) {
+                for (int j = 0; j < TAMANO_GRUPO_LOTE; j++) {
+                    const NodoPlano& nodo = arbol[actual[j]];
+                    actual[j] = nodo.hijos[rama(nodo, entradas[inicio + j])];
+                }
+            }
+            for (int j = 0; j < TAMANO_GRUPO_LOTE; j++) hojas[inicio + j] = actual[j];
+        }
+        for (; inicio < n; inicio++) {
+            uint16_t actual = 0;
+            for (int nivel = 0; nivel < profundidad; nivel++) {
+                actual = arbol[actual].hijos[rama(arbol[actual], entradas[inicio])];
+            }
+            hojas[inicio] = actual;
+        }
+    }
+    
+    // Acciones de una hoja (p. ej. devuelta por decidirLote) - O(1)
+    RangoAcciones getAccionesHoja(uint16_t hoja) const {
+        const AccionControl* primera = accionesHojas.data() + nodos.at(hoja).primeraAccion;
+        RangoAcciones rango = {primera, primera + nodos[hoja].numAcciones};
+        return rango;
+    }
+    
+    const std::string& getEtiqueta(uint16_t nodo) const { return etiquetas.at(nodo); }
+    int getCantidadNodos() const { return (int)nodos.size(); }
+    int getProfundidad() const { return profundidad; }
+    int getVersion() const { return version; }
+    
+    // Escribir el árbol en el formato de ConfiguracionControl - O(n)
+    // Sirve como plantilla para ajustar umbrales sin recompilar.
+    void escribir(std::ostream& salida) const {
+        salida << "FORMATO:ARBOL 1\n";
+        for (size_t i = 0; i < nodos.size(); ++i) {
+            const NodoPlano& nodo = nodos[i];
+            if (nodo.esHoja) {
+                salida << "HOJA:N" << i << "|" << etiquetas[i] << "\n";
+                for (const auto& accion : getAccionesHoja((uint16_t)i)) {
+                    salida << "ACCION:N" << i << "|" << accion.actuador << "|"
+                           << accion.intensidad << "|" << accion.razon << "\n";
+                }
+            } else {
+                salida << "NODO:N" << i << "|" << etiquetas[i] << "|" << condiciones[i]
+                       << "|N" << nodo.hijos[0] << "|N" << nodo.hijos[1] << "\n";
+            }
+        }
+        salida << "FIN\n";
+    }
+    
+    // Valor de sensor para el camino: "sin dato" si es NaN, un decimal si no
+    static std::string formatearValor(double valor) {
+        if (std::isnan(valor)) return "sin dato";
+        std::ostringstream texto;
+        texto << std::fixed << std::setprecision(1) << valor;
+        return texto.str();
+    }
+
+    // Obtener camino de decisión (vacío si el trazado está desactivado)
+    // Los textos se arman aquí, a pedido, a partir de los nodos visitados.
     std::vector<std::string> getCaminoDecision() const {
-        return caminoDecision;
+        std::vector<std::string> camino;
+        for (size_t k = 0; k < nodosCamino.size(); ++k) {
+            uint16_t i = nodosCamino[k];
+            const NodoPlano& nodo = nodos[i];
+            if (nodo.esHoja) {
+                camino.push_back("ACCION|" + etiquetas[i]);
+                continue;
+            }
+            if (i == 0) {
+                camino.push_back("RAIZ|" + condiciones[i]);
+            } else {
+                camino.push_back("DECISION|" + etiquetas[i] + "|" + condiciones[i]);
+            }
+            camino.push_back(std::string(ramasCamino[k] == 0 ? "SI|" : "NO|") + nombreVariable(nodo.variable) +
+                             "|" + formatearValor(valoresSensores[nodo.variable]) + "|" + condiciones[i]);
+        }
+        return camino;
     }
     
-    // VISUALIZAR ÁRBOL COMPLETO
-    void mostrarArbol() {
+    // VISUALIZAR ÁRBOL COMPLETO (generado a partir de los nodos reales)
+    void mostrarArbol() const {
         std::cout << "\n";
         std::cout << "+===============================================================+\n";
         std::cout << "|          ARBOL DE DECISION DEL INVERNADERO                    |\n";
         std::cout << "+===============================================================+\n\n";
         
-        std::cout << "ESTRUCTURA DEL ARBOL:\n\n";
+        std::cout << "ESTRUCTURA DEL ARBOL";
+        if (version > 0) std::cout << " (archivo, version " << version << ")";
+        else std::cout << " (predefinido)";
+        std::cout << ":\n\n";
+        mostrarSubarbol(0, "  ");
         
-        std::cout << "                        [RAIZ]\n";
-        std::cout << "                   (Temp > 35C?)\n";
-        std::cout << "                    /         \\\n";
-        std::cout << "                  SI           NO\n";
-        std::cout << "                 /               \\\n";
-        std::cout << "          [ENFRIAR MAX]      (Temp < 15C?)\n";
-        std::cout << "           Vent:100%           /         \\\n";
-        std::cout << "           Neb:100%          SI           NO\n";
-        std::cout << "                            /               \\\n";
-        std::cout << "                      [CALENTAR]      (HumSuelo < 40%?)\n";
-        std::cout << "                       Calef:90%        /           \\\n";
-        std::cout << "                                      SI             NO\n";
-        std::cout << "                                     /                 \\\n";
-        std::cout << "                              [REGAR]            (HumRel < 60%?)\n";
-        std::cout << "                              Riego:100%           /          \\\n";
-        std::cout << "                              Neb:50%            SI            NO\n";
-        std::cout << "                                                /                \\\n";
-        std::cout << "                                         [NEBULIZAR]        [MANTENER]\n";
-        std::cout << "                                         Neb:80%            Vent:25%\n";
-        std::cout << "                                         Vent:15%           Riego:30%\n";
-        std::cout << "                                                            Luz:60%\n\n";
-        
-        std::cout << "+===============================================================+\n";
-        std::cout << "|                TABLA DE DECISIONES                            |\n";
-        std::cout << "+===============================================================+\n\n";
-        std::cout << "  Nivel 1: Temp > 35C?  --> SI: ENFRIAR MAXIMO\n";
-        std::cout << "                        --> NO: Continuar\n\n";
-        std::cout << "  Nivel 2: Temp < 15C?  --> SI: CALENTAR\n";
-        std::cout << "                        --> NO: Continuar\n\n";
-        std::cout << "  Nivel 3: HumSuelo < 40%? --> SI: REGAR INTENSO\n";
-        std::cout << "                           --> NO: Continuar\n\n";
-        std::cout << "  Nivel 4: HumRel < 60%? --> SI: NEBULIZAR\n";
-        std::cout << "                         --> NO: MANTENER OPTIMO\n\n";
-        
-        std::cout << "+===============================================================+\n";
+        std::cout << "\n+===============================================================+\n";
         std::cout << "|                DESCRIPCION DE ACCIONES                        |\n";
         std::cout << "+===============================================================+\n\n";
         
-        std::cout << "1. ENFRIAR MAXIMO:\n";
-        std::cout << "   - Ventilador al 100 por ciento\n";
-        std::cout << "   - Nebulizador al 100 por ciento\n";
-        std::cout << "   - Apagar calefaccion\n\n";
-        
-        std::cout << "2. CALENTAR:\n";
-        std::cout << "   - Calefactor al 90 por ciento\n";
-        std::cout << "   - Apagar ventilacion\n\n";
-        
-        std::cout << "3. REGAR INTENSO:\n";
-        std::cout << "   - Riego al 100 por ciento\n";
-        std::cout << "   - Nebulizador al 50 por ciento\n";
-        std::cout << "   - Ventilador al 20 por ciento\n\n";
-        
-        std::cout << "4. NEBULIZAR:\n";
-        std::cout << "   - Nebulizador al 80 por ciento\n";
-        std::cout << "   - Ventilador al 15 por ciento\n";
-        std::cout << "   - Riego al 30 por ciento\n\n";
-        
-        std::cout << "5. MANTENER OPTIMO:\n";
-        std::cout << "   - Ventilador al 25 por ciento\n";
-        std::cout << "   - Riego al 30 por ciento\n";
-        std::cout << "   - Luz LED al 60 por ciento\n\n";
+        int hojas = 0;
+        for (size_t i = 0; i < nodos.size(); ++i) {
+            if (!nodos[i].esHoja) continue;
+            std::cout << ++hojas << ". " << etiquetas[i] << ":\n";
+            RangoAcciones acciones = getAccionesHoja((uint16_t)i);
+            if (acciones.empty()) std::cout << "   - Sin acciones\n";
+            for (const auto& accion : acciones) {
+                std::cout << "   - " << accion.actuador << " al " << (int)accion.intensidad
+                          << " por ciento (" << accion.razon << ")\n";
+            }
+            std::cout << "\n";
+        }
         
         std::cout << "+===============================================================+\n";
-        std::cout << "|  ESTADISTICAS: Profundidad=4, Nodos=9, Hojas=5               |\n";
+        std::cout << "|  ESTADISTICAS: Profundidad=" << profundidad << ", Nodos=" << nodos.size()
+                  << ", Hojas=" << hojas << "\n";
         std::cout << "+===============================================================+\n\n";
     }
     
     // VISUALIZAR PROCESO DE DECISIÓN
     void mostrarProcesoDecision() {
+        if (!trazado) {
+            std::cout << "\n  (Trazado de decisiones desactivado)\n";
+            return;
+        }
+        std::vector<std::string> caminoDecision = getCaminoDecision();
+        
         std::cout << "\n";
         std::cout << "+===============================================================+\n";
         std::cout << "|              CAMINO DE DECISION TOMADO                        |\n";
@@ -275,9 +484,9 @@ public:
         
         std::cout << "VALORES ACTUALES:\n";
         std::cout << "+-- Temperatura:    " << std::fixed << std::setprecision(1) 
-                  << valoresSensores["TEMP"] << " grados C\n";
-        std::cout << "+-- Humedad Suelo:  " << valoresSensores["HUM_SUELO"] << " por ciento\n";
-        std::cout << "+-- Humedad Relat:  " << valoresSensores["HUM_REL"] << " por ciento\n\n";
+                  << valoresSensores[VAR_TEMP] << " grados C\n";
+        std::cout << "+-- Humedad Suelo:  " << valoresSensores[VAR_HUM_SUELO] << " por ciento\n";
+        std::cout << "+-- Humedad Relat:  " << valoresSensores[VAR_HUM_REL] << " por ciento\n\n";
         
         std::cout << "RECORRIDO:\n\n";
         
@@ -327,7 +536,7 @@ public:
         std::cout << "|                 ACCIONES A EJECUTAR                           |\n";
         std::cout << "+===============================================================+\n\n";
         
-        for (const auto& accion : accionesFinales) {
+        for (const auto& accion : getAccionesHoja(ultimaHoja)) {
             int barras = (int)accion.intensidad / 10;
             std::string barra = "[";
             for (int i = 0; i < 10; ++i) {
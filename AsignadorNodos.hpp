@@ -0,0 +1,208 @@
+#ifndef ASIGNADOR_NODOS_HPP
+#define ASIGNADOR_NODOS_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Estadisticas de uso de un asignador de nodos
+struct EstadisticasAsignador {
+    long reservas;       // nodos entregados
+    long liberaciones;   // nodos devueltos
+    long enUso;          // nodos vivos actualmente
+    long maxEnUso;       // pico de nodos vivos
+    long bloques;        // bloques pedidos al sistema (llamadas reales a new)
+
+    EstadisticasAsignador() : reservas(0), liberaciones(0), enUso(0),
+                              maxEnUso(0), bloques(0) {}
+
+    void registrarReserva() {
+        reservas++;
+        enUso++;
+        if (enUso > maxEnUso) maxEnUso = enUso;
+    }
+
+    void registrarLiberacion() {
+        liberaciones++;
+        enUso--;
+    }
+};
+
+// Asignador por defecto: un new/delete por nodo (comportamiento original)
+template <typename N>
+class AsignadorNew {
+private:
+    EstadisticasAsignador estadisticas;
+
+public:
+    // Los contenedores no pueden omitir el recorrido de limpiar() con este asignador
+    static const bool liberacionMasiva = false;
+
+    template <typename... Args>
+    N* crear(Args&&... args) {
+        N* nodo = new N(std::forward<Args>(args)...);
+        estadisticas.registrarReserva();
+        estadisticas.bloques++;
+        return nodo;
+    }
+
+    void destruir(N* nodo) {
+        delete nodo;
+        estadisticas.registrarLiberacion();
+    }
+
+    void reiniciar() {}
+
+    const EstadisticasAsignador& getEstadisticas() const { return estadisticas; }
+};
+
+// Bloque de ranuras compartido por el pool y la arena
+template <typename N, int NodosPorBloque>
+struct BloqueNodos {
+    union Ranura {
+        Ranura* siguienteLibre;
+        alignas(N) unsigned char memoria[sizeof(N)];
+    };
+
+    BloqueNodos* siguiente;
+    Ranura ranuras[NodosPorBloque];
+
+    BloqueNodos() : siguiente(nullptr) {}
+};
+
+// Pool con lista libre: los nodos liberados se reutilizan sin volver a malloc
+// Reserva bloques de NodosPorBloque ranuras y nunca los devuelve hasta destruirse.
+template <typename N, int NodosPorBloque = 64>
+class PoolNodos {
+private:
+    typedef BloqueNodos<N, NodosPorBloque> Bloque;
+    typedef typename Bloque::Ranura Ranura;
+
+    Bloque* bloques;       // lista de bloques reservados
+    Ranura* libres;        // lista libre de ranuras devueltas
+    int usadasBloqueActual; // ranuras ya entregadas del bloque mas reciente
+    EstadisticasAsignador estadisticas;
+
+    Ranura* obtenerRanura() {
+        if (libres) {
+            Ranura* ranura = libres;
+            libres = libres->siguienteLibre;
+            return ranura;
+        }
+        if (!bloques || usadasBloqueActual == NodosPorBloque) {
+            Bloque* nuevo = new Bloque();
+            nuevo->siguiente = bloques;
+            bloques = nuevo;
+            usadasBloqueActual = 0;
+            estadisticas.bloques++;
+        }
+        return &bloques->ranuras[usadasBloqueActual++];
+    }
+
+public:
+    static const bool liberacionMasiva = false;
+
+    PoolNodos() : bloques(nullptr), libres(nullptr), usadasBloqueActual(0) {}
+
+    PoolNodos(const PoolNodos&) = delete;
+    PoolNodos& operator=(const PoolNodos&) = delete;
+
+    ~PoolNodos() {
+        while (bloques) {
+            Bloque* temp = bloques;
+            bloques = bloques->siguiente;
+            delete temp;
+        }
+    }
+
+    // Construir nodo en una ranura libre - O(1)
+    template <typename... Args>
+    N* crear(Args&&... args) {
+        Ranura* ranura = obtenerRanura();
+        N* nodo = new (ranura->memoria) N(std::forward<Args>(args)...);
+        estadisticas.registrarReserva();
+        return nodo;
+    }
+
+    // Destruir nodo y devolver su ranura a la lista libre - O(1)
+    void destruir(N* nodo) {
+        nodo->~N();
+        Ranura* ranura = reinterpret_cast<Ranura*>(nodo);
+        ranura->siguienteLibre = libres;
+        libres = ranura;
+        estadisticas.registrarLiberacion();
+    }
+
+    void reiniciar() {}
+
+    const EstadisticasAsignador& getEstadisticas() const { return estadisticas; }
+};
+
+// Arena de asignacion lineal: crear() solo avanza un puntero y destruir()
+// no recupera memoria; reiniciar() libera todos los nodos de una vez y
+// conserva los bloques para la siguiente ronda.
+template <typename N, int NodosPorBloque = 256>
+class ArenaNodos {
+private:
+    typedef BloqueNodos<N, NodosPorBloque> Bloque;
+
+    Bloque* primero;
+    Bloque* actual;
+    int usadasBloqueActual;
+    EstadisticasAsignador estadisticas;
+
+public:
+    // Con T trivialmente destructible limpiar() puede llamar solo a reiniciar()
+    static const bool liberacionMasiva = true;
+
+    ArenaNodos() : primero(nullptr), actual(nullptr), usadasBloqueActual(0) {}
+
+    ArenaNodos(const ArenaNodos&) = delete;
+    ArenaNodos& operator=(const ArenaNodos&) = delete;
+
+    ~ArenaNodos() {
+        while (primero) {
+            Bloque* temp = primero;
+            primero = primero->siguiente;
+            delete temp;
+        }
+    }
+
+    // Construir nodo al final del bloque actual - O(1)
+    template <typename... Args>
+    N* crear(Args&&... args) {
+        if (!actual || usadasBloqueActual == NodosPorBloque) {
+            Bloque* siguiente = actual ? actual->siguiente : primero;
+            if (!siguiente) {
+                siguiente = new Bloque();
+                if (actual) actual->siguiente = siguiente;
+                else primero = siguiente;
+                estadisticas.bloques++;
+            }
+            actual = siguiente;
+            usadasBloqueActual = 0;
+        }
+        N* nodo = new (actual->ranuras[usadasBloqueActual++].memoria)
+            N(std::forward<Args>(args)...);
+        estadisticas.registrarReserva();
+        return nodo;
+    }
+
+    // Solo ejecuta el destructor; la memoria vuelve en reiniciar()
+    void destruir(N* nodo) {
+        nodo->~N();
+        estadisticas.registrarLiberacion();
+    }
+
+    // Liberacion masiva: invalida todos los nodos sin recorrerlos - O(1)
+    void reiniciar() {
+        actual = nullptr;
+        usadasBloqueActual = 0;
+        estadisticas.liberaciones += estadisticas.enUso;
+        estadisticas.enUso = 0;
+    }
+
+    const EstadisticasAsignador& getEstadisticas() const { return estadisticas; }
+};
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef BANCO_SENSORES_HPP
+#define BANCO_SENSORES_HPP
+
+#include "Lectura.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Banco de N sensores de un mismo tipo en estructura de arreglos (SoA)
+// Valores, rangos, umbrales y deriva viven en arreglos contiguos, asi que
+// avanzar() y evaluarEstados() son bucles planos sin llamadas virtuales ni
+// saltos que el compilador puede vectorizar (SSE/AVX con -O3).
+// Cada sensor lleva su propio generador xorshift32 para que el ruido tambien
+// se calcule carril a carril, sin el estado global de rand().
+class BancoSensores {
+private:
+    std::vector<float> valores;
+    std::vector<float> minimos;
+    std::vector<float> maximos;
+    std::vector<float> umbralesAlerta;
+    std::vector<float> umbralesCriticos;
+    std::vector<float> pisosCriticos;   // rangoMin + 5% del rango: tambien es critico
+    std::vector<float> tendencias;      // desplazamiento fijo por paso
+    std::vector<float> amplitudesRuido; // el ruido es uniforme en [-amplitud, amplitud)
+    std::vector<uint32_t> generadores;  // estado xorshift32 por sensor (nunca 0)
+    std::vector<uint8_t> estados;       // EstadoLectura por sensor
+    std::vector<uint16_t> ids;          // id internado para exportar lecturas
+
+public:
+    BancoSensores() {}
+
+    explicit BancoSensores(int capacidadInicial) {
+        reservar(capacidadInicial);
+    }
+
+    void reservar(int capacidad) {
+        valores.reserve(capacidad);
+        minimos.reserve(capacidad);
+        maximos.reserve(capacidad);
+        umbralesAlerta.reserve(capacidad);
+        umbralesCriticos.reserve(capacidad);
+        pisosCriticos.reserve(capacidad);
+        tendencias.reserve(capacidad);
+        amplitudesRuido.reserve(capacidad);
+        generadores.reserve(capacidad);
+        estados.reserve(capacidad);
+        ids.reserve(capacidad);
+    }
+
+    // Agregar sensor y retornar su posicion en el banco - O(1) amortizado
+    int agregar(const std::string& id, double valorInicial, double min, double max,
+                double alerta, double critico, double tendencia, double amplitudRuido,
+                uint32_t semilla) {
+        if (min > max) {
+            throw std::invalid_argument("Rango invalido");
+        }
+        valores.push_back((float)std::min(std::max(valorInicial, min), max));
+        minimos.push_back((float)min);
+        maximos.push_back((float)max);
+        umbralesAlerta.push_back((float)alerta);
+        umbralesCriticos.push_back((float)critico);
+        pisosCriticos.push_back((float)(min + (max - min) * 0.05));
+        tendencias.push_back((float)tendencia);
+        amplitudesRuido.push_back((float)amplitudRuido);
+        generadores.push_back(semilla ? semilla : 0x9E3779B9u);
+        estados.push_back(ESTADO_NORMAL);
+        ids.push_back(RegistroSensores::registrar(id));
+        return (int)valores.size() - 1;
+    }
+
+    // Avanzar un paso de simulacion todos los sensores - O(n), vectorizable
+    void avanzar() {
+        const int n = (int)valores.size();
+        float* v = valores.data();
+        uint32_t* g = generadores.data();
+        const float* lo = minimos.data();
+        const float* hi = maximos.data();
+        const float* tend = tendencias.data();
+        const float* amp = amplitudesRuido.data();
+        const float escala = 2.0f / 16777216.0f; // 24 bits -> [0, 2)
+
+        for (int i = 0; i < n; i++) {
+            uint32_t x = g[i];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            g[i] = x;
+            float ruido = ((float)(x >> 8) * escala - 1.0f) * amp[i];
+            float nuevo = v[i] + tend[i] + ruido;
+            nuevo = nuevo < lo[i] ? lo[i] : nuevo;
+            v[i] = nuevo > hi[i] ? hi[i] : nuevo;
+        }
+    }
+
+    // Comparar contra umbrales y escribir el estado de cada sensor - O(n), vectorizable
+    // Misma regla que Sensor::evaluarEstado: critico si supera el umbral critico
+    // o cae en el 5% inferior del rango; alerta si supera el umbral de alerta.
+    void evaluarEstados() {
+        const int n = (int)valores.size();
+        const float* v = valores.data();
+        const float* alerta = umbralesAlerta.data();
+        const float* critico = umbralesCriticos.data();
+        const float* piso = pisosCriticos.data();
+        uint8_t* e = estados.data();
+
+        for (int i = 0; i < n; i++) {
+            uint8_t esCritico = (uint8_t)((v[i] >= critico[i]) | (v[i] <= piso[i]));
+            uint8_t esAlerta = (uint8_t)(v[i] >= alerta[i]);
+            uint8_t nivelCritico = (uint8_t)(esCritico * ESTADO_CRITICO);
+            e[i] = nivelCritico > esAlerta ? nivelCritico : esAlerta;
+        }
+    }
+
+    void avanzarYEvaluar() {
+        avanzar();
+        evaluarEstados();
+    }
+
+    // Escribir en salida las lecturas de [desde, desde + cantidad) - O(cantidad)
+    // Pensado para publicar el banco por lotes en la cola de ingesta
+    int exportarLecturas(int64_t tiempoMs, int desde, int cantidad, Lectura* salida) const {
+        int fin = std::min(desde + cantidad, (int)valores.size());
+        int escritas = 0;
+        for (int i = desde; i < fin; i++) {
+            salida[escritas++] = Lectura(tiempoMs, 0, ids[i], valores[i], (EstadoLectura)estados[i]);
+        }
+        return escritas;
+    }
+
+    // Desplazar un sensor (actuacion externa) respetando su rango - O(1)
+    void ajustar(int i, double delta) {
+        float nuevo = valores.at(i) + (float)delta;
+        valores[i] = std::min(std::max(nuevo, minimos[i]), maximos[i]);
+    }
+
+    double getValor(int i) const { return valores.at(i); }
+    EstadoLectura getEstado(int i) const { return (EstadoLectura)estados.at(i); }
+    uint16_t getIdInterno(int i) const { return ids.at(i); }
+    int getTamano() const { return (int)valores.size(); }
+
+    // Acceso directo a los arreglos para procesamiento por lotes
+    const float* getValores() const { return valores.data(); }
+    const uint8_t* getEstados() const { return estados.data(); }
+
+    // Cantidad de sensores en cada estado - O(n)
+    int contarEstado(EstadoLectura estado) const {
+        return (int)std::count(estados.begin(), estados.end(), (uint8_t)estado);
+    }
+};
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef BUFFER_CIRCULAR_HPP
+#define BUFFER_CIRCULAR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Buffer circular de capacidad fija (historial acotado)
+// Todo el almacenamiento se reserva en el constructor: al llenarse, cada
+// insercion sobrescribe el elemento mas antiguo sin pedir memoria nueva.
+template <typename T>
+class BufferCircular {
+private:
+    std::vector<T> datos;
+    int capacidad;
+    int inicio;   // posicion fisica del elemento mas antiguo
+    int tamano;
+
+    // Convertir indice logico (0 = mas antiguo) a posicion fisica - O(1)
+    int posicionFisica(int indice) const {
+        int pos = inicio + indice;
+        return pos >= capacidad ? pos - capacidad : pos;
+    }
+
+    // Iterador de acceso aleatorio por indice logico (0 = mas antiguo)
+    template <typename B, typename V>
+    class Iterador {
+    private:
+        B* buffer;
+        int indice;
+
+        template <typename, typename> friend class Iterador;
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename std::remove_const<V>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V* pointer;
+        typedef V& reference;
+
+        Iterador(B* _buffer = nullptr, int _indice = 0) : buffer(_buffer), indice(_indice) {}
+
+        template <typename B2, typename W,
+                  typename = typename std::enable_if<std::is_convertible<W*, V*>::value>::type>
+        Iterador(const Iterador<B2, W>& otro) : buffer(otro.buffer), indice(otro.indice) {}
+
+        reference operator*() const { return buffer->datos[buffer->posicionFisica(indice)]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        Iterador& operator++() { indice++; return *this; }
+        Iterador operator++(int) { Iterador copia = *this; indice++; return copia; }
+        Iterador& operator--() { indice--; return *this; }
+        Iterador operator--(int) { Iterador copia = *this; indice--; return copia; }
+        Iterador& operator+=(difference_type n) { indice += (int)n; return *this; }
+        Iterador& operator-=(difference_type n) { indice -= (int)n; return *this; }
+        Iterador operator+(difference_type n) const { return Iterador(buffer, indice + (int)n); }
+        Iterador operator-(difference_type n) const { return Iterador(buffer, indice - (int)n); }
+        friend Iterador operator+(difference_type n, const Iterador& it) { return it + n; }
+        difference_type operator-(const Iterador& otro) const { return indice - otro.indice; }
+
+        bool operator==(const Iterador& otro) const { return indice == otro.indice; }
+        bool operator!=(const Iterador& otro) const { return indice != otro.indice; }
+        bool operator<(const Iterador& otro) const { return indice < otro.indice; }
+        bool operator>(const Iterador& otro) const { return indice > otro.indice; }
+        bool operator<=(const Iterador& otro) const { return indice <= otro.indice; }
+        bool operator>=(const Iterador& otro) const { return indice >= otro.indice; }
+    };
+
+    // Reservar la posicion del siguiente elemento, descartando el mas antiguo
+    // si el buffer esta lleno - O(1)
+    T& ranuraFinal(bool& descartado) {
+        if (tamano < capacidad) {
+            descartado = false;
+            return datos[posicionFisica(tamano++)];
+        }
+        descartado = true;
+        T& ranura = datos[inicio];
+        inicio = (inicio + 1 == capacidad) ? 0 : inicio + 1;
+        return ranura;
+    }
+
+public:
+    typedef Iterador<BufferCircular, T> iterator;
+    typedef Iterador<const BufferCircular, const T> const_iterator;
+
+    explicit BufferCircular(int _capacidad)
+        : capacidad(_capacidad), inicio(0), tamano(0) {
+        if (capacidad <= 0) {
+            throw std::invalid_argument("Capacidad invalida");
+        }
+        datos.resize(capacidad);
+    }
+
+    // Insertar al final - O(1)
+    // Retorna true si se descarto el elemento mas antiguo para hacer espacio
+    bool insertarFinal(const T& dato) {
+        bool descartado;
+        ranuraFinal(descartado) = dato;
+        return descartado;
+    }
+
+    bool insertarFinal(T&& dato) {
+        bool descartado;
+        ranuraFinal(descartado) = std::move(dato);
+        return descartado;
+    }
+
+    // Construir el elemento y moverlo a la ranura reservada - O(1)
+    template <typename... Args>
+    bool emplazarFinal(Args&&... args) {
+        bool descartado;
+        ranuraFinal(descartado) = T(std::forward<Args>(args)...);
+        return descartado;
+    }
+
+    // Eliminar elemento mas antiguo - O(1)
+    T eliminarInicio() {
+        if (estaVacia()) {
+            throw std::runtime_error("Buffer vacio");
+        }
+        T dato = std::move(datos[inicio]);
+        inicio = (inicio + 1 == capacidad) ? 0 : inicio + 1;
+        tamano--;
+        return dato;
+    }
+
+    // Acceso por indice logico (0 = mas antiguo) - O(1)
+    T& obtener(int indice) {
+        if (indice < 0 || indice >= tamano) {
+            throw std::out_of_range("Indice fuera de rango");
+        }
+        return datos[posicionFisica(indice)];
+    }
+
+    const T& obtener(int indice) const {
+        if (indice < 0 || indice >= tamano) {
+            throw std::out_of_range("Indice fuera de rango");
+        }
+        return datos[posicionFisica(indice)];
+    }
+
+    T& primero() {
+        if (estaVacia()) {
+            throw std::runtime_error("Buffer vacio");
+        }
+        return datos[inicio];
+    }
+
+    const T& primero() const {
+        if (estaVacia()) {
+            throw std::runtime_error("Buffer vacio");
+        }
+        return datos[inicio];
+    }
+
+    T& ultimo() {
+        if (estaVacia()) {
+            throw std::runtime_error("Buffer vacio");
+        }
+        return datos[posicionFisica(tamano - 1)];
+    }
+
+    const T& ultimo() const {
+        if (estaVacia()) {
+            throw std::runtime_error("Buffer vacio");
+        }
+        return datos[posicionFisica(tamano - 1)];
+    }
+
+    bool estaVacia() const { return tamano == 0; }
+    bool estaLleno() const { return tamano == capacidad; }
+    int getTamano() const { return tamano; }
+    int getCapacidad() const { return capacidad; }
+
+    // Vaciar sin liberar la memoria reservada - O(1)
+    void limpiar() {
+        inicio = 0;
+        tamano = 0;
+    }
+
+    // Iteradores del mas antiguo al mas reciente
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, tamano); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, tamano); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // Recorrido del mas antiguo al mas reciente
+    template <typename Func>
+    void recorrerAdelante(Func funcion) const {
+        for (int i = 0; i < tamano; i++) {
+            funcion(datos[posicionFisica(i)]);
+        }
+    }
+
+    // Recorrido del mas reciente al mas antiguo
+    template <typename Func>
+    void recorrerAtras(Func funcion) const {
+        for (int i = tamano - 1; i >= 0; i--) {
+            funcion(datos[posicionFisica(i)]);
+        }
+    }
+
+    // Obtener todos los elementos en orden cronologico
+    std::vector<T> obtenerTodos() const {
+        std::vector<T> resultado;
+        resultado.reserve(tamano);
+        for (int i = 0; i < tamano; i++) {
+            resultado.push_back(datos[posicionFisica(i)]);
+        }
+        return resultado;
+    }
+};
+
+#endif
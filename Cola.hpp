@@ -2,27 +2,21 @@
 #define COLA_HPP
 
 #include "Nodo.hpp"
+#include "AsignadorNodos.hpp"
+#include "Iteradores.hpp"
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-template <typename T>
+template <typename T, template <typename> class Asignador = AsignadorNew>
 class Cola {
 private:
     Nodo<T>* frente;
     Nodo<T>* final;
     int tamano;
+    Asignador<Nodo<T>> asignador;
 
-public:
-    Cola() : frente(nullptr), final(nullptr), tamano(0) {}
-
-    ~Cola() {
-        while (!estaVacia()) {
-            dequeue();
-        }
-    }
-
-    // Insertar elemento al final - O(1)
-    void enqueue(T dato) {
-        Nodo<T>* nuevo = new Nodo<T>(dato);
+    void encadenar(Nodo<T>* nuevo) {
         if (estaVacia()) {
             frente = final = nuevo;
         } else {
@@ -32,24 +26,53 @@ public:
         tamano++;
     }
 
+public:
+    // Los iteradores recorren desde el frente hacia el final
+    typedef IteradorNodo<Nodo<T>, T> iterator;
+    typedef IteradorNodo<Nodo<T>, const T> const_iterator;
+
+    Cola() : frente(nullptr), final(nullptr), tamano(0) {}
+
+    ~Cola() {
+        limpiar();
+    }
+
+    // Insertar elemento al final - O(1)
+    void enqueue(const T& dato) { encadenar(asignador.crear(dato)); }
+    void enqueue(T&& dato) { encadenar(asignador.crear(std::move(dato))); }
+
+    // Construir el elemento directamente al final - O(1)
+    template <typename... Args>
+    T& emplazar(Args&&... args) {
+        encadenar(asignador.crear(std::forward<Args>(args)...));
+        return final->dato;
+    }
+
     // Eliminar y retornar elemento del frente - O(1)
     T dequeue() {
         if (estaVacia()) {
             throw std::runtime_error("Cola vacia");
         }
         Nodo<T>* temp = frente;
-        T dato = frente->dato;
+        T dato = std::move(frente->dato);
         frente = frente->siguiente;
         if (frente == nullptr) {
             final = nullptr;
         }
-        delete temp;
+        asignador.destruir(temp);
         tamano--;
         return dato;
     }
 
     // Ver elemento del frente sin eliminarlo - O(1)
-    T front() const {
+    T& front() {
+        if (estaVacia()) {
+            throw std::runtime_error("Cola vacia");
+        }
+        return frente->dato;
+    }
+
+    const T& front() const {
         if (estaVacia()) {
             throw std::runtime_error("Cola vacia");
         }
@@ -64,11 +87,32 @@ public:
         return tamano;
     }
 
+    // Con una arena y T trivial se libera todo de golpe sin recorrer - O(1)
     void limpiar() {
-        while (!estaVacia()) {
-            dequeue();
+        if (Asignador<Nodo<T>>::liberacionMasiva && std::is_trivially_destructible<T>::value) {
+            asignador.reiniciar();
+        } else {
+            while (frente != nullptr) {
+                Nodo<T>* temp = frente;
+                frente = frente->siguiente;
+                asignador.destruir(temp);
+            }
+            asignador.reiniciar();
         }
+        frente = final = nullptr;
+        tamano = 0;
     }
+
+    const EstadisticasAsignador& getEstadisticasMemoria() const {
+        return asignador.getEstadisticas();
+    }
+
+    iterator begin() { return iterator(frente); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(frente); }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
 };
 
 #endif
@@ -0,0 +1,150 @@
+#ifndef COLA_MPMC_HPP
+#define COLA_MPMC_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+// Cola acotada sin bloqueos para multiples productores y consumidores (MPMC)
+// Cada celda lleva un numero de secuencia que indica si esta libre para la
+// vuelta actual del productor o lista para el consumidor; los hilos reclaman
+// posiciones con CAS. Los lotes reclaman varias celdas consecutivas con un
+// solo CAS, asi que un lote de k elementos cuesta una operacion atomica
+// compartida en lugar de k.
+template <typename T>
+class ColaMPMC {
+private:
+    struct Celda {
+        std::atomic<size_t> secuencia;
+        T dato;
+    };
+
+    Celda* celdas;
+    size_t mascara;
+    int capacidad;
+    alignas(64) std::atomic<size_t> posEncolar;
+    alignas(64) std::atomic<size_t> posDesencolar;
+
+    // Reclamar hasta n celdas libres consecutivas para el productor
+    // Retorna la cantidad reclamada y su posicion inicial en 'inicio'
+    int reclamarParaEncolar(int n, size_t& inicio) {
+        size_t pos = posEncolar.load(std::memory_order_relaxed);
+        while (true) {
+            int libres = 0;
+            while (libres < n) {
+                Celda& celda = celdas[(pos + libres) & mascara];
+                size_t sec = celda.secuencia.load(std::memory_order_acquire);
+                if (sec != pos + libres) break;
+                libres++;
+            }
+            if (libres == 0) {
+                // Llena, o otro productor avanzo: releer antes de rendirse
+                size_t actual = posEncolar.load(std::memory_order_relaxed);
+                if (actual == pos) return 0;
+                pos = actual;
+                continue;
+            }
+            if (posEncolar.compare_exchange_weak(pos, pos + libres, std::memory_order_relaxed)) {
+                inicio = pos;
+                return libres;
+            }
+        }
+    }
+
+    // Reclamar hasta n celdas listas consecutivas para el consumidor
+    int reclamarParaDesencolar(int n, size_t& inicio) {
+        size_t pos = posDesencolar.load(std::memory_order_relaxed);
+        while (true) {
+            int listas = 0;
+            while (listas < n) {
+                Celda& celda = celdas[(pos + listas) & mascara];
+                size_t sec = celda.secuencia.load(std::memory_order_acquire);
+                if (sec != pos + listas + 1) break;
+                listas++;
+            }
+            if (listas == 0) {
+                size_t actual = posDesencolar.load(std::memory_order_relaxed);
+                if (actual == pos) return 0;
+                pos = actual;
+                continue;
+            }
+            if (posDesencolar.compare_exchange_weak(pos, pos + listas, std::memory_order_relaxed)) {
+                inicio = pos;
+                return listas;
+            }
+        }
+    }
+
+public:
+    // La capacidad se redondea a la siguiente potencia de 2
+    explicit ColaMPMC(int _capacidad = 1024) : posEncolar(0), posDesencolar(0) {
+        if (_capacidad < 2) {
+            throw std::invalid_argument("Capacidad invalida");
+        }
+        size_t tam = 2;
+        while (tam < (size_t)_capacidad) tam <<= 1;
+        capacidad = (int)tam;
+        mascara = tam - 1;
+        celdas = new Celda[tam];
+        for (size_t i = 0; i < tam; i++) {
+            celdas[i].secuencia.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ColaMPMC(const ColaMPMC&) = delete;
+    ColaMPMC& operator=(const ColaMPMC&) = delete;
+
+    ~ColaMPMC() {
+        delete[] celdas;
+    }
+
+    // Encolar un elemento si hay espacio - O(1)
+    bool intentarEncolar(T dato) {
+        return intentarEncolarLote(&dato, 1) == 1;
+    }
+
+    // Desencolar un elemento si hay datos - O(1)
+    bool intentarDesencolar(T& salida) {
+        return intentarDesencolarLote(&salida, 1) == 1;
+    }
+
+    // Encolar hasta n elementos de lote (se mueven fuera del arreglo) - O(n)
+    // Retorna cuantos se encolaron; los restantes quedan intactos en lote
+    int intentarEncolarLote(T* lote, int n) {
+        if (n <= 0) return 0;
+        size_t inicio;
+        int reclamadas = reclamarParaEncolar(n, inicio);
+        for (int i = 0; i < reclamadas; i++) {
+            Celda& celda = celdas[(inicio + i) & mascara];
+            celda.dato = std::move(lote[i]);
+            celda.secuencia.store(inicio + i + 1, std::memory_order_release);
+        }
+        return reclamadas;
+    }
+
+    // Desencolar hasta max elementos en salida - O(max)
+    int intentarDesencolarLote(T* salida, int max) {
+        if (max <= 0) return 0;
+        size_t inicio;
+        int reclamadas = reclamarParaDesencolar(max, inicio);
+        for (int i = 0; i < reclamadas; i++) {
+            Celda& celda = celdas[(inicio + i) & mascara];
+            salida[i] = std::move(celda.dato);
+            celda.secuencia.store(inicio + i + mascara + 1, std::memory_order_release);
+        }
+        return reclamadas;
+    }
+
+    // Tamano aproximado bajo concurrencia
+    int getTamano() const {
+        size_t e = posEncolar.load(std::memory_order_acquire);
+        size_t d = posDesencolar.load(std::memory_order_acquire);
+        return e > d ? (int)(e - d) : 0;
+    }
+
+    bool estaVacia() const { return getTamano() == 0; }
+    int getCapacidad() const { return capacidad; }
+};
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef COLA_SPSC_HPP
+#define COLA_SPSC_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+// Cola acotada sin bloqueos para un productor y un consumidor (SPSC)
+// Buffer circular de Capacidad ranuras (potencia de 2) reservado en linea:
+// encolar y desencolar no piden memoria ni toman locks. Solo un hilo puede
+// llamar a intentarEncolar y solo un hilo a intentarDesencolar.
+template <typename T, int Capacidad>
+class ColaSPSC {
+private:
+    static_assert(Capacidad >= 2 && (Capacidad & (Capacidad - 1)) == 0,
+                  "La capacidad debe ser potencia de 2");
+    static const size_t MASCARA = Capacidad - 1;
+
+    // Indices monotonos; cada uno en su propia linea de cache para evitar
+    // que productor y consumidor se invaliden mutuamente (false sharing)
+    alignas(64) std::atomic<size_t> lectura;   // escrito solo por el consumidor
+    alignas(64) size_t escrituraCache;         // copia local del consumidor
+    alignas(64) std::atomic<size_t> escritura; // escrito solo por el productor
+    alignas(64) size_t lecturaCache;           // copia local del productor
+    alignas(64) T datos[Capacidad];
+
+public:
+    ColaSPSC() : lectura(0), escrituraCache(0), escritura(0), lecturaCache(0) {}
+
+    ColaSPSC(const ColaSPSC&) = delete;
+    ColaSPSC& operator=(const ColaSPSC&) = delete;
+
+    // Productor: encolar si hay espacio - O(1)
+    template <typename U>
+    bool intentarEncolar(U&& dato) {
+        size_t pos = escritura.load(std::memory_order_relaxed);
+        if (pos - lecturaCache == (size_t)Capacidad) {
+            lecturaCache = lectura.load(std::memory_order_acquire);
+            if (pos - lecturaCache == (size_t)Capacidad) return false;
+        }
+        datos[pos & MASCARA] = std::forward<U>(dato);
+        escritura.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: desencolar si hay datos - O(1)
+    bool intentarDesencolar(T& salida) {
+        size_t pos = lectura.load(std::memory_order_relaxed);
+        if (pos == escrituraCache) {
+            escrituraCache = escritura.load(std::memory_order_acquire);
+            if (pos == escrituraCache) return false;
+        }
+        salida = std::move(datos[pos & MASCARA]);
+        lectura.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Tamano aproximado (exacto solo si ningun otro hilo opera)
+    int getTamano() const {
+        size_t e = escritura.load(std::memory_order_acquire);
+        size_t l = lectura.load(std::memory_order_acquire);
+        return (int)(e - l);
+    }
+
+    bool estaVacia() const { return getTamano() == 0; }
+    int getCapacidad() const { return Capacidad; }
+};
+
+// Que hacer cuando el productor encuentra la cola llena
+enum PoliticaCola {
+    BLOQUEAR,            // esperar hasta que haya espacio
+    DESCARTAR_NUEVO,     // rechazar el elemento y contarlo como descartado
+    ESPERAR_CON_LIMITE   // esperar hasta un tiempo maximo y luego descartar
+};
+
+// Envoltorio con espera activa sobre ColaSPSC (sin mutex ni variables de
+// condicion): gira brevemente y luego cede el procesador con yield.
+template <typename T, int Capacidad>
+class ColaSPSCBloqueante {
+private:
+    ColaSPSC<T, Capacidad> cola;
+    PoliticaCola politica;
+    std::chrono::microseconds limiteEspera;
+    std::atomic<long> descartados;
+
+    static void esperarTurno(int& intentos) {
+        if (++intentos < 64) return;
+        std::this_thread::yield();
+    }
+
+public:
+    explicit ColaSPSCBloqueante(PoliticaCola _politica = BLOQUEAR,
+                                std::chrono::microseconds _limite = std::chrono::milliseconds(10))
+        : politica(_politica), limiteEspera(_limite), descartados(0) {}
+
+    // Productor: encolar aplicando la politica de contrapresion
+    // Retorna false si el elemento fue descartado
+    template <typename U>
+    bool encolar(U&& dato) {
+        if (cola.intentarEncolar(std::forward<U>(dato))) return true;
+        if (politica == DESCARTAR_NUEVO) {
+            descartados.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        std::chrono::steady_clock::time_point limite = std::chrono::steady_clock::now() + limiteEspera;
+        int intentos = 0;
+        while (!cola.intentarEncolar(std::forward<U>(dato))) {
+            if (politica == ESPERAR_CON_LIMITE && std::chrono::steady_clock::now() >= limite) {
+                descartados.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            esperarTurno(intentos);
+        }
+        return true;
+    }
+
+    // Consumidor: no bloqueante
+    bool intentarDesencolar(T& salida) {
+        return cola.intentarDesencolar(salida);
+    }
+
+    // Consumidor: esperar hasta que llegue un elemento
+    T desencolar() {
+        T salida;
+        int intentos = 0;
+        while (!cola.intentarDesencolar(salida)) {
+            esperarTurno(intentos);
+        }
+        return salida;
+    }
+
+    int getTamano() const { return cola.getTamano(); }
+    bool estaVacia() const { return cola.estaVacia(); }
+    long getDescartados() const { return descartados.load(std::memory_order_relaxed); }
+    PoliticaCola getPolitica() const { return politica; }
+};
+
+#endif
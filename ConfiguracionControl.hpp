@@ -0,0 +1,353 @@
+#ifndef CONFIGURACION_CONTROL_HPP
+#define CONFIGURACION_CONTROL_HPP
+
+#include "ArbolDecision.hpp"
+#include "Grafo.hpp"
+#include "Actuador.hpp"
+#include "Predicado.hpp"
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Carga del arbol de decision y del grafo de estados desde archivos de texto
+// Una linea por registro con formato CLAVE:campo|campo|..., comentarios con
+// '#' y la primera linea indica tipo y version:
+//
+//   FORMATO:ARBOL 1
+//   NODO:id|etiqueta|condicion|idSi|idNo     (el primer nodo es la raiz)
+//   HOJA:id|etiqueta
+//   ACCION:idHoja|ACTUADOR|intensidad|razon
+//   FIN
+//
+//   FORMATO:GRAFO 1
+//   ESTADO:nombre|descripcion
+//   CONFIG:estado|ACTUADOR|intensidad         (los cinco actuadores por estado)
+//   TRANSICION:origen|destino|condicion|prioridad[|histeresis|confirmaciones|permanenciaMs]
+//   INICIAL:estado
+//   FIN
+//
+// Todo se valida y se compila al cargar (incluidas las tablas de caminos
+// del grafo); ante cualquier error se lanza runtime_error con el numero de
+// linea y no se devuelve nada a medias, asi que la estructura activa solo se
+// reemplaza por una version completa.
+class ConfiguracionControl {
+public:
+    static const int VERSION_FORMATO = 1;
+
+private:
+    struct Registro {
+        int linea;
+        std::string clave;
+        std::vector<std::string> campos;
+    };
+
+    static std::runtime_error error(int linea, const std::string& mensaje) {
+        return std::runtime_error("Linea " + std::to_string(linea) + ": " + mensaje);
+    }
+
+    static std::string recortar(const std::string& texto) {
+        size_t inicio = texto.find_first_not_of(" \t\r");
+        if (inicio == std::string::npos) return "";
+        size_t fin = texto.find_last_not_of(" \t\r");
+        return texto.substr(inicio, fin - inicio + 1);
+    }
+
+    // Leer todos los registros hasta FIN y verificar tipo y version
+    static std::vector<Registro> leerRegistros(std::istream& entrada, const std::string& tipo) {
+        std::vector<Registro> registros;
+        std::string linea;
+        int numero = 0;
+        bool encabezado = false;
+        bool fin = false;
+
+        while (std::getline(entrada, linea)) {
+            numero++;
+            linea = recortar(linea);
+            if (linea.empty() || linea[0] == '#') continue;
+            if (linea == "FIN") {
+                fin = true;
+                break;
+            }
+
+            size_t posicion = linea.find(':');
+            if (posicion == std::string::npos) {
+                throw error(numero, "se esperaba CLAVE:valor");
+            }
+            Registro registro;
+            registro.linea = numero;
+            registro.clave = linea.substr(0, posicion);
+            std::stringstream resto(linea.substr(posicion + 1));
+            std::string campo;
+            while (std::getline(resto, campo, '|')) {
+                registro.campos.push_back(recortar(campo));
+            }
+
+            if (!encabezado) {
+                std::istringstream formato(registro.campos.empty() ? "" : registro.campos[0]);
+                std::string tipoArchivo;
+                int version = 0;
+                formato >> tipoArchivo >> version;
+                if (registro.clave != "FORMATO" || tipoArchivo != tipo) {
+                    throw error(numero, "se esperaba FORMATO:" + tipo);
+                }
+                if (version != VERSION_FORMATO) {
+                    throw error(numero, "version de formato no soportada: " + std::to_string(version));
+                }
+                encabezado = true;
+                continue;
+            }
+            registros.push_back(registro);
+        }
+
+        if (!encabezado) throw error(numero, "archivo vacio");
+        if (!fin) throw error(numero, "falta FIN");
+        return registros;
+    }
+
+    static void exigirCampos(const Registro& registro, size_t cantidad) {
+        if (registro.campos.size() != cantidad) {
+            throw error(registro.linea, registro.clave + " necesita " + std::to_string(cantidad) + " campos");
+        }
+    }
+
+    static double leerNumero(const Registro& registro, const std::string& texto) {
+        size_t leidos = 0;
+        double valor;
+        try {
+            valor = std::stod(texto, &leidos);
+        } catch (const std::exception&) {
+            throw error(registro.linea, "numero invalido: " + texto);
+        }
+        if (leidos != texto.size() || !std::isfinite(valor)) {
+            throw error(registro.linea, "numero invalido: " + texto);
+        }
+        return valor;
+    }
+
+    // Entero en [minimo, maximo]; rechaza fracciones en vez de truncarlas
+    static long long leerEntero(const Registro& registro, const std::string& texto,
+                                long long minimo, long long maximo) {
+        double valor = leerNumero(registro, texto);
+        if (valor != std::floor(valor)) throw error(registro.linea, "se esperaba un entero: " + texto);
+        if (valor < (double)minimo || valor > (double)maximo) {
+            throw error(registro.linea, "fuera de rango [" + std::to_string(minimo) + ", " +
+                        std::to_string(maximo) + "]: " + texto);
+        }
+        return (long long)valor;
+    }
+
+    static double leerIntensidad(const Registro& registro, const std::string& texto) {
+        double intensidad = leerNumero(registro, texto);
+        if (intensidad < 0.0 || intensidad > 100.0) {
+            throw error(registro.linea, "intensidad fuera de 0-100: " + texto);
+        }
+        return intensidad;
+    }
+
+    static IdActuador leerActuador(const Registro& registro, const std::string& nombre) {
+        int id = buscarActuador(nombre);
+        if (id < 0) throw error(registro.linea, "actuador desconocido: " + nombre);
+        return (IdActuador)id;
+    }
+
+    static void validarCondicion(const Registro& registro, const std::string& condicion) {
+        try {
+            Predicado::compilar(condicion);
+        } catch (const std::invalid_argument& e) {
+            throw error(registro.linea, e.what());
+        }
+    }
+
+public:
+    // Leer y validar un arbol de decision - O(n)
+    static std::shared_ptr<ArbolDecision> cargarArbol(std::istream& entrada) {
+        std::vector<Registro> registros = leerRegistros(entrada, "ARBOL");
+
+        struct Definicion {
+            int linea;
+            bool esHoja;
+            std::string etiqueta;
+            std::string condicion;
+            std::string hijos[2];
+            std::vector<AccionControl> acciones;
+        };
+        std::map<std::string, Definicion> definiciones;
+        std::string raiz;
+
+        for (const Registro& registro : registros) {
+            if (registro.clave == "NODO" || registro.clave == "HOJA") {
+                bool esHoja = registro.clave == "HOJA";
+                exigirCampos(registro, esHoja ? 2 : 5);
+                const std::string& id = registro.campos[0];
+                if (definiciones.count(id)) throw error(registro.linea, "nodo repetido: " + id);
+
+                Definicion def;
+                def.linea = registro.linea;
+                def.esHoja = esHoja;
+                def.etiqueta = registro.campos[1];
+                if (!esHoja) {
+                    def.condicion = registro.campos[2];
+                    validarCondicion(registro, def.condicion);
+                    def.hijos[0] = registro.campos[3];
+                    def.hijos[1] = registro.campos[4];
+                }
+                definiciones[id] = def;
+                if (raiz.empty()) raiz = id;
+            } else if (registro.clave == "ACCION") {
+                exigirCampos(registro, 4);
+                auto it = definiciones.find(registro.campos[0]);
+                if (it == definiciones.end() || !it->second.esHoja) {
+                    throw error(registro.linea, "ACCION debe seguir a su HOJA: " + registro.campos[0]);
+                }
+                IdActuador actuador = leerActuador(registro, registro.campos[1]);
+                it->second.acciones.push_back(AccionControl(
+                    actuador, leerIntensidad(registro, registro.campos[2]), registro.campos[3]));
+            } else {
+                throw error(registro.linea, "clave desconocida: " + registro.clave);
+            }
+        }
+        if (raiz.empty()) throw error(0, "el arbol no tiene nodos");
+
+        // Debe ser un arbol: cada nodo con un solo padre y todos alcanzables
+        std::map<std::string, int> padres;
+        for (const auto& par : definiciones) {
+            if (par.second.esHoja) continue;
+            for (const std::string& hijo : par.second.hijos) {
+                if (!definiciones.count(hijo)) throw error(par.second.linea, "hijo inexistente: " + hijo);
+                if (hijo == raiz) throw error(par.second.linea, "la raiz no puede ser hija de otro nodo");
+                if (++padres[hijo] > 1) throw error(par.second.linea, "nodo con dos padres: " + hijo);
+            }
+        }
+        // Recorrer desde la raiz: un ciclo separado o un nodo que es su propio
+        // hijo tienen padre pero no se alcanzan
+        std::map<std::string, bool> visitados;
+        std::vector<std::string> pendientes(1, raiz);
+        while (!pendientes.empty()) {
+            std::string id = pendientes.back();
+            pendientes.pop_back();
+            visitados[id] = true;
+            const Definicion& def = definiciones[id];
+            if (def.esHoja) continue;
+            for (const std::string& hijo : def.hijos) pendientes.push_back(hijo);
+        }
+        for (const auto& par : definiciones) {
+            if (!visitados.count(par.first)) {
+                throw error(par.second.linea, "nodo inalcanzable: " + par.first);
+            }
+        }
+
+        // Armar los nodos (ya sin ciclos posibles) y aplanarlos. Mientras no
+        // esten enlazados cada nodo es de su unique_ptr; una vez enlazados
+        // (sin nada que pueda lanzar en medio) la raiz es duena de todo el arbol.
+        std::map<std::string, std::unique_ptr<NodoDecision>> nodos;
+        for (const auto& par : definiciones) {
+            const Definicion& def = par.second;
+            std::unique_ptr<NodoDecision> nodo(new NodoDecision(def.etiqueta, def.condicion));
+            nodo->esHoja = def.esHoja;
+            nodo->acciones = def.acciones;
+            nodos[par.first] = std::move(nodo);
+        }
+        for (const auto& par : definiciones) {
+            if (par.second.esHoja) continue;
+            nodos[par.first]->izquierdo = nodos[par.second.hijos[0]].get();
+            nodos[par.first]->derecho = nodos[par.second.hijos[1]].get();
+        }
+        for (auto& par : nodos) {
+            if (par.first != raiz) par.second.release();
+        }
+        int version = VERSION_FORMATO;
+        return std::make_shared<ArbolDecision>(nodos[raiz].get(), version);
+    }
+
+    // Leer y validar un grafo de estados - O(E + T)
+    static std::shared_ptr<GrafoEstados> cargarGrafo(std::istream& entrada) {
+        std::vector<Registro> registros = leerRegistros(entrada, "GRAFO");
+        std::shared_ptr<GrafoEstados> grafo = std::make_shared<GrafoEstados>(false);
+        grafo->setVersion(VERSION_FORMATO);
+        std::string inicial;
+
+        // Los errores del grafo (estado repetido o desconocido, filtro
+        // invalido...) llegan como logic_error; se reportan con la linea
+        for (const Registro& registro : registros) {
+            try {
+                if (registro.clave == "ESTADO") {
+                    exigirCampos(registro, 2);
+                    grafo->agregarEstado(registro.campos[0], registro.campos[1]);
+                } else if (registro.clave == "CONFIG") {
+                    exigirCampos(registro, 3);
+                    IdActuador actuador = leerActuador(registro, registro.campos[1]);
+                    grafo->configurarActuador(registro.campos[0], actuador,
+                                              leerIntensidad(registro, registro.campos[2]));
+                } else if (registro.clave == "INICIAL") {
+                    exigirCampos(registro, 1);
+                    inicial = registro.campos[0];
+                } else if (registro.clave != "TRANSICION") {
+                    throw error(registro.linea, "clave desconocida: " + registro.clave);
+                }
+            } catch (const std::logic_error& e) {
+                throw error(registro.linea, e.what());
+            }
+        }
+        // Transiciones al final: pueden nombrar estados declarados despues
+        for (const Registro& registro : registros) {
+            if (registro.clave != "TRANSICION") continue;
+            if (registro.campos.size() != 7) exigirCampos(registro, 4);
+            validarCondicion(registro, registro.campos[2]);
+            int prioridad = (int)leerEntero(registro, registro.campos[3], INT_MIN, INT_MAX);
+            Transicion transicion(registro.campos[1], registro.campos[2], prioridad);
+            if (registro.campos.size() == 7) {
+                transicion.histeresis = leerNumero(registro, registro.campos[4]);
+                transicion.confirmaciones = (int)leerEntero(registro, registro.campos[5], 1, UINT16_MAX);
+                // Hasta ~285 000 anios: cualquier valor mayor ya no es exacto en double
+                transicion.permanenciaMinimaMs = leerEntero(registro, registro.campos[6], 0, 1LL << 53);
+            }
+            try {
+                grafo->agregarTransicion(registro.campos[0], transicion);
+            } catch (const std::logic_error& e) {
+                throw error(registro.linea, e.what());
+            }
+        }
+
+        if (grafo->getCantidadEstados() == 0) throw error(0, "el grafo no tiene estados");
+        for (const Registro& registro : registros) {
+            if (registro.clave != "ESTADO") continue;
+            if (!grafo->configuracionCompleta(registro.campos[0])) {
+                throw error(registro.linea, "el estado " + registro.campos[0] +
+                            " debe configurar los " + std::to_string((int)NUM_ACTUADORES) + " actuadores");
+            }
+        }
+        if (inicial.empty() || !grafo->existeEstado(inicial)) {
+            throw error(0, "falta INICIAL o nombra un estado inexistente");
+        }
+        // Tablas de transiciones y caminos listas antes de publicar; todo
+        // estado debe poder alcanzarse desde el inicial
+        grafo->compilar();
+        grafo->setEstadoActual(inicial);
+        std::vector<std::string> inalcanzables = grafo->estadosInalcanzables(inicial);
+        if (!inalcanzables.empty()) {
+            throw error(0, "estado inalcanzable desde " + inicial + ": " + inalcanzables[0]);
+        }
+        return grafo;
+    }
+
+    // Variantes por archivo - lanzan runtime_error si no se puede abrir
+    static std::shared_ptr<ArbolDecision> cargarArbolArchivo(const std::string& ruta) {
+        std::ifstream archivo(ruta);
+        if (!archivo.is_open()) throw std::runtime_error("No se pudo abrir " + ruta);
+        return cargarArbol(archivo);
+    }
+
+    static std::shared_ptr<GrafoEstados> cargarGrafoArchivo(const std::string& ruta) {
+        std::ifstream archivo(ruta);
+        if (!archivo.is_open()) throw std::runtime_error("No se pudo abrir " + ruta);
+        return cargarGrafo(archivo);
+    }
+};
+
+#endif
@@ -4,9 +4,99 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include "ReduccionSIMD.hpp"
+#include "SketchCuantiles.hpp"
+#include "VentanaDeslizante.hpp"
+
+// Acumulador incremental (Welford): cantidad, media, varianza, minimo y maximo
+// Cada dato se agrega en O(1) sin guardarlo, con una sola pasada y sin la
+// cancelacion numerica de sumar cuadrados. Dos acumuladores se pueden
+// combinar (Chan et al.), p. ej. para unir sensores o hilos.
+class AcumuladorEstadistico {
+private:
+    long cantidad;
+    double media;
+    double m2;        // suma de cuadrados de las desviaciones a la media
+    double minimo;
+    double maximo;
+
+public:
+    AcumuladorEstadistico() { limpiar(); }
+
+    // Partir del resultado de una reduccion por lotes (ReduccionSIMD)
+    explicit AcumuladorEstadistico(const Momentos& m)
+        : cantidad(m.cantidad), media(m.media), m2(m.m2), minimo(m.minimo), maximo(m.maximo) {}
+
+    // Agregar un dato - O(1)
+    void agregar(double x) {
+        cantidad++;
+        double delta = x - media;
+        media += delta / cantidad;
+        m2 += delta * (x - media);
+        if (x < minimo) minimo = x;
+        if (x > maximo) maximo = x;
+    }
+
+    // Incorporar los datos de otro acumulador - O(1)
+    void combinar(const AcumuladorEstadistico& otro) {
+        if (otro.cantidad == 0) return;
+        if (cantidad == 0) {
+            *this = otro;
+            return;
+        }
+        long total = cantidad + otro.cantidad;
+        double delta = otro.media - media;
+        media += delta * otro.cantidad / total;
+        m2 += otro.m2 + delta * delta * ((double)cantidad * otro.cantidad / total);
+        cantidad = total;
+        minimo = std::min(minimo, otro.minimo);
+        maximo = std::max(maximo, otro.maximo);
+    }
+
+    void limpiar() {
+        cantidad = 0;
+        media = 0.0;
+        m2 = 0.0;
+        minimo = std::numeric_limits<double>::infinity();
+        maximo = -std::numeric_limits<double>::infinity();
+    }
+
+    long getCantidad() const { return cantidad; }
+    double promedio() const { return media; }
+
+    // Varianza muestral (n - 1), igual que calcularDesviacion
+    double varianza() const { return cantidad < 2 ? 0.0 : m2 / (cantidad - 1); }
+    double desviacion() const { return std::sqrt(varianza()); }
+    double getMinimo() const { return cantidad ? minimo : 0.0; }
+    double getMaximo() const { return cantidad ? maximo : 0.0; }
+    double rango() const { return cantidad ? maximo - minimo : 0.0; }
+};
+
+// Estado en flujo de un sensor: momentos exactos y cuantiles aproximados
+// Ocupa memoria constante aunque el historial abarque meses de lecturas.
+struct EstadisticasFlujo {
+    AcumuladorEstadistico momentos;
+    SketchCuantiles cuantiles;
+
+    // Agregar un dato - O(1) amortizado
+    void agregar(double x) {
+        momentos.agregar(x);
+        cuantiles.agregar(x);
+    }
+
+    void combinar(const EstadisticasFlujo& otro) {
+        momentos.combinar(otro.momentos);
+        cuantiles.combinar(otro.cuantiles);
+    }
+};
 
 class Estadisticas {
 public:
+    // Hasta este tamano los percentiles se calculan exactos con nth_element;
+    // por encima se estiman con un SketchCuantiles
+    static const size_t LIMITE_EXACTO = 100000;
+
     static double calcularPromedio(const std::vector<double>& datos) {
         if (datos.empty()) return 0.0;
         double suma = 0.0;
@@ -14,15 +104,23 @@ public:
         return suma / datos.size();
     }
 
+    // Cantidad, media, varianza, minimo y maximo en una sola pasada
+    // vectorizada (AVX2/SSE2 segun la CPU) - O(n)
+    static AcumuladorEstadistico resumir(const double* datos, size_t n) {
+        return AcumuladorEstadistico(ReduccionSIMD::resumir(datos, n));
+    }
+
+    static AcumuladorEstadistico resumir(const float* datos, size_t n) {
+        return AcumuladorEstadistico(ReduccionSIMD::resumir(datos, n));
+    }
+
+    static AcumuladorEstadistico resumir(const std::vector<double>& datos) {
+        return resumir(datos.data(), datos.size());
+    }
+
     static double calcularDesviacion(const std::vector<double>& datos) {
         if (datos.size() < 2) return 0.0;
-        double promedio = calcularPromedio(datos);
-        double sumaCuadrados = 0.0;
-        for (double d : datos) {
-            double diferencia = d - promedio;
-            sumaCuadrados += diferencia * diferencia;
-        }
-        return std::sqrt(sumaCuadrados / (datos.size() - 1));
+        return resumir(datos).desviacion();
     }
 
     static double encontrarMinimo(const std::vector<double>& datos) {
@@ -37,16 +135,47 @@ public:
 
     static double calcularRango(const std::vector<double>& datos) {
         if (datos.empty()) return 0.0;
-        return encontrarMaximo(datos) - encontrarMinimo(datos);
+        return resumir(datos).rango();
     }
 
+    // Mediana exacta con seleccion parcial - O(n) en promedio
     static double calcularMediana(std::vector<double> datos) {
         if (datos.empty()) return 0.0;
-        std::sort(datos.begin(), datos.end());
+        size_t mitad = datos.size() / 2;
+        std::nth_element(datos.begin(), datos.begin() + mitad, datos.end());
         if (datos.size() % 2 == 1) {
-            return datos[datos.size() / 2];
+            return datos[mitad];
+        }
+        // El elemento anterior a la mitad es el maximo de la parte inferior
+        double inferior = *std::max_element(datos.begin(), datos.begin() + mitad);
+        return (inferior + datos[mitad]) / 2.0;
+    }
+
+    // Percentil q en [0, 1] con interpolacion lineal entre rangos vecinos
+    // Exacto en O(n) promedio hasta LIMITE_EXACTO datos; con mas datos se
+    // estima con un sketch (memoria O(k), error de rango ~1.7/k).
+    static double calcularPercentil(const std::vector<double>& datos, double q) {
+        if (datos.empty()) return 0.0;
+        q = std::min(std::max(q, 0.0), 1.0);
+
+        if (datos.size() > LIMITE_EXACTO) {
+            SketchCuantiles sketch(SketchCuantiles::kParaError(0.001));
+            for (double d : datos) sketch.agregar(d);
+            return sketch.cuantil(q);
+        }
+
+        std::vector<double> copia(datos);
+        double posicion = q * (copia.size() - 1);
+        size_t bajo = (size_t)posicion;
+        double fraccion = posicion - bajo;
+        std::nth_element(copia.begin(), copia.begin() + bajo, copia.end());
+        double valorBajo = copia[bajo];
+        if (fraccion == 0.0 || bajo + 1 >= copia.size()) {
+            return valorBajo;
         }
-        return (datos[datos.size() / 2 - 1] + datos[datos.size() / 2]) / 2.0;
+        // Tras nth_element el siguiente rango es el minimo de la parte superior
+        double valorAlto = *std::min_element(copia.begin() + bajo + 1, copia.end());
+        return valorBajo + (valorAlto - valorBajo) * fraccion;
     }
 };
 
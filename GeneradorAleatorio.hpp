@@ -0,0 +1,70 @@
+#ifndef GENERADOR_ALEATORIO_HPP
+#define GENERADOR_ALEATORIO_HPP
+
+#include <cstdint>
+#include <string>
+
+// Generador PCG32 (O'Neill): 16 bytes de estado, rapido y reproducible
+// Cada sensor tiene el suyo, asi que leer() no comparte estado global como
+// rand() y dos sensores en hilos distintos no compiten. Cumple los requisitos
+// de UniformRandomBitGenerator para usarse con <random> si hace falta.
+class GeneradorAleatorio {
+private:
+    uint64_t estado;
+    uint64_t incremento; // debe ser impar; selecciona una de 2^63 secuencias
+
+public:
+    typedef uint32_t result_type;
+
+    explicit GeneradorAleatorio(uint64_t semilla = 0x853c49e6748fea9bULL, uint64_t secuencia = 0xda3e39cb94b95bdbULL) {
+        sembrar(semilla, secuencia);
+    }
+
+    void sembrar(uint64_t semilla, uint64_t secuencia = 0xda3e39cb94b95bdbULL) {
+        estado = 0;
+        incremento = (secuencia << 1) | 1u;
+        siguiente();
+        estado += semilla;
+        siguiente();
+    }
+
+    // Siguiente valor de 32 bits - O(1)
+    uint32_t siguiente() {
+        uint64_t anterior = estado;
+        estado = anterior * 6364136223846793005ULL + incremento;
+        uint32_t mezclado = (uint32_t)(((anterior >> 18) ^ anterior) >> 27);
+        uint32_t rotacion = (uint32_t)(anterior >> 59);
+        return (mezclado >> rotacion) | (mezclado << ((32 - rotacion) & 31));
+    }
+
+    // Entero en [0, limite) por multiplicacion (sin division) - O(1)
+    uint32_t entero(uint32_t limite) {
+        return (uint32_t)(((uint64_t)siguiente() * limite) >> 32);
+    }
+
+    // Real en [0, 1) con 32 bits de resolucion - O(1)
+    double uniforme() {
+        return siguiente() * (1.0 / 4294967296.0);
+    }
+
+    // Real en [minimo, maximo) - O(1)
+    double uniforme(double minimo, double maximo) {
+        return minimo + (maximo - minimo) * uniforme();
+    }
+
+    // Semilla estable derivada de un texto (FNV-1a), p. ej. el id del sensor
+    static uint64_t semillaDe(const std::string& texto) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (unsigned char c : texto) {
+            hash ^= c;
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()() { return siguiente(); }
+};
+
+#endif
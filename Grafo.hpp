@@ -4,253 +4,707 @@
 #include <string>
 #include <vector>
 #include <map>
-#include <queue>
-#include <set>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include "Actuador.hpp"
+#include "Predicado.hpp"
+#include "BufferCircular.hpp"
+
+// Intensidad de cada actuador en un estado, indexada por IdActuador
+struct ConfiguracionActuadores {
+    double intensidades[NUM_ACTUADORES];
+
+    double operator[](int actuador) const { return intensidades[actuador]; }
+};
 
 // Representa un estado del invernadero
 struct EstadoInvernadero {
     std::string nombre;
     std::string descripcion;
-    std::map<std::string, double> configuracionActuadores;
-    
-    EstadoInvernadero(std::string n, std::string desc) 
-        : nombre(n), descripcion(desc) {}
+    ConfiguracionActuadores configuracion;
+    uint8_t configurados; // bit i: el actuador i tiene intensidad definida
+
+    EstadoInvernadero(std::string n, std::string desc)
+        : nombre(n), descripcion(desc), configurados(0) {
+        for (int i = 0; i < NUM_ACTUADORES; ++i) configuracion.intensidades[i] = 0.0;
+    }
 };
 
-// Arista del grafo con condici�n de transici�n
+// Arista del grafo con condici�n de transici�n (forma de texto, para construir)
+// Filtros contra el ruido de los sensores:
+//   histeresis:    una vez cumplida, la condici�n se sigue contando mientras el
+//                  valor no se aleje m�s de esta banda del umbral
+//   confirmaciones: ciclos seguidos que debe cumplirse antes de disparar
+//   permanenciaMinimaMs: tiempo m�nimo en el estado de origen
+// Con los valores por defecto se dispara en la primera muestra, como antes.
 struct Transicion {
     std::string estadoDestino;
     std::string condicion;
     int prioridad;
-    
-    Transicion(std::string dest, std::string cond, int prior = 1)
-        : estadoDestino(dest), condicion(cond), prioridad(prior) {}
+    double histeresis;
+    int confirmaciones;
+    int64_t permanenciaMinimaMs;
+
+    Transicion(std::string dest, std::string cond, int prior = 1,
+               double _histeresis = 0.0, int _confirmaciones = 1, int64_t _permanenciaMinimaMs = 0)
+        : estadoDestino(dest), condicion(cond), prioridad(prior), histeresis(_histeresis),
+          confirmaciones(_confirmaciones), permanenciaMinimaMs(_permanenciaMinimaMs) {}
+
+    bool tieneFiltros() const {
+        return histeresis != 0.0 || confirmaciones != 1 || permanenciaMinimaMs != 0;
+    }
+};
+
+// Fila de la tabla de transiciones: condici�n ya compilada y destino por id,
+// junto con el estado incremental del filtro (se reinicia al entrar al origen)
+struct TransicionCompilada {
+    Predicado predicado;
+    uint16_t destino;
+    int prioridad;
+    double histeresis;
+    uint16_t confirmaciones;
+    int64_t permanenciaMinimaMs;
+
+    uint16_t ciclosCumplidos; // ciclos seguidos con la condici�n cumplida
+    bool cumplidaAntes;
+    bool retenida;            // el filtro la retuvo en alg�n ciclo de este episodio
+
+    // Actualizar con la muestra del ciclo - O(1)
+    // Devuelve true si termina un episodio retenido sin llegar a disparar
+    // (la condici�n sali� de la banda antes de confirmarse).
+    bool actualizar(const ValoresControl& sensores) {
+        bool cumple = predicado.evaluar(sensores) ||
+                      (cumplidaAntes && predicado.evaluar(sensores, histeresis));
+        bool abandonada = !cumple && retenida;
+        cumplidaAntes = cumple;
+        if (!cumple) {
+            ciclosCumplidos = 0;
+            retenida = false;
+        } else if (ciclosCumplidos < confirmaciones) {
+            ciclosCumplidos++;
+        }
+        return abandonada;
+    }
+
+    bool pendiente() const { return ciclosCumplidos > 0; }
+
+    bool confirmada(int64_t permanenciaMs) const {
+        return ciclosCumplidos >= confirmaciones && permanenciaMs >= permanenciaMinimaMs;
+    }
+
+    void reiniciar() {
+        ciclosCumplidos = 0;
+        cumplidaAntes = false;
+        retenida = false;
+    }
+};
+
+// Registro del historial: estado al que se entr�, cu�ndo y con qu� valor
+// de la variable que dispar� la transici�n (NaN para el estado inicial)
+struct CambioEstado {
+    uint16_t estado;
+    uint8_t variable;
+    int64_t entradaMs;
+    double valorDisparo;
+
+    CambioEstado()
+        : estado(0), variable(VAR_TEMP), entradaMs(0), valorDisparo(std::numeric_limits<double>::quiet_NaN()) {}
+    CambioEstado(uint16_t _estado, int64_t _entradaMs, uint8_t _variable, double _valor)
+        : estado(_estado), variable(_variable), entradaMs(_entradaMs), valorDisparo(_valor) {}
+};
+
+// Tiempo acumulado en un estado (solo estancias ya terminadas)
+struct PermanenciaEstado {
+    long visitas;
+    int64_t totalMs;
+    int64_t maximoMs;
+
+    PermanenciaEstado() : visitas(0), totalMs(0), maximoMs(0) {}
+
+    double promedioMs() const { return visitas > 0 ? (double)totalMs / visitas : 0.0; }
+};
+
+// Peso de una arista al planificar caminos entre estados
+enum CriterioCamino {
+    CAMINO_SALTOS,   // cada transici�n cuesta 1
+    CAMINO_ENERGIA   // cuesta la potencia (kW) del estado al que se entra
 };
 
 // Grafo de estados para control del invernadero
+// Estados y actuadores se identifican con enteros densos. Las transiciones
+// se guardan en una tabla ordenada por (origen, prioridad) con un �ndice de
+// inicio por estado, as� que evaluar es recorrer unas pocas filas contiguas
+// y el ciclo de control no reserva memoria.
+// Los caminos m�nimos entre todos los pares se precalculan (Floyd-Warshall)
+// al terminar de construir o cargar el grafo; las consultas son O(1).
 class GrafoEstados {
 private:
-    std::map<std::string, EstadoInvernadero*> estados;
-    std::map<std::string, std::vector<Transicion>> transiciones;
-    std::string estadoActual;
-    std::vector<std::string> historialEstados;
-    
-    bool evaluarCondicionTransicion(std::string condicion, 
-                                    std::map<std::string, double>& sensores) {
-        // Similar a ArbolDecision, pero m�s espec�fico para transiciones
-        size_t posOperador = condicion.find_first_of("<>=");
-        if (posOperador == std::string::npos) return false;
-        
-        std::string sensor = condicion.substr(0, posOperador);
-        sensor.erase(0, sensor.find_first_not_of(" \t"));
-        sensor.erase(sensor.find_last_not_of(" \t") + 1);
-        
-        char operador = condicion[posOperador];
-        double umbral = std::stod(condicion.substr(posOperador + 1));
-        
-        if (sensores.find(sensor) == sensores.end()) return false;
-        
-        double valorSensor = sensores[sensor];
-        
-        switch(operador) {
-            case '>': return valorSensor > umbral;
-            case '<': return valorSensor < umbral;
-            case '=': return std::abs(valorSensor - umbral) < 0.1;
-            default: return false;
+    static const int MAX_HISTORIAL = 50;
+    static const uint16_t SIN_CAMINO = UINT16_MAX;   // en siguienteSalto; ning�n id llega a este valor
+
+    std::vector<EstadoInvernadero> estados;         // indexados por id
+    std::map<std::string, int> idsPorNombre;        // solo al construir y consultar
+    std::vector<std::pair<int, Transicion>> definiciones; // (origen, transici�n) en orden de carga
+    std::vector<Predicado> predicadosDefinidos;     // condici�n compilada de cada definici�n
+
+    std::vector<TransicionCompilada> tabla;
+    std::vector<int> inicioTransiciones;            // filas de e: [inicio[e], inicio[e + 1])
+    std::vector<int> definicionDeFila;              // fila -> �ndice en definiciones
+    bool tablaValida;                               // false si hay definiciones sin compilar
+
+    // Tablas de caminos, n x n en orden de filas (origen * n + destino)
+    CriterioCamino criterioCaminos;
+    std::vector<double> distancias;                 // infinito si no hay camino
+    std::vector<uint16_t> siguienteSalto;           // primer estado del camino; SIN_CAMINO si no hay
+    bool caminosValidos;                            // false si cambi� el grafo desde el c�lculo
+
+    int estadoActual;
+    int64_t entradaEstadoMs;          // -1 hasta la primera evaluaci�n en el estado
+    long transicionesSuprimidas;      // episodios retenidos que nunca dispararon
+    long cambiosEstado;
+    int64_t ultimaEvaluacionMs;
+    BufferCircular<CambioEstado> historialEstados;  // �ltimas MAX_HISTORIAL entradas a estados
+    std::vector<PermanenciaEstado> permanencias;    // por id de estado
+    int version; // version del archivo de configuracion; 0 = predefinido
+
+    // Cerrar la estancia en el estado actual - O(1)
+    void registrarSalida(int64_t ahoraMs) {
+        PermanenciaEstado& p = permanencias[estadoActual];
+        int64_t duracion = ahoraMs - entradaEstadoMs;
+        p.visitas++;
+        p.totalMs += duracion;
+        if (duracion > p.maximoMs) p.maximoMs = duracion;
+    }
+
+    void exigirCaminos() const {
+        if (!caminosValidos) {
+            throw std::logic_error("Caminos sin precalcular: llamar a precalcularCaminos()");
         }
     }
 
-public:
-    GrafoEstados() {
-        estadoActual = "NORMAL";
-        construirGrafo();
+    void exigirTabla() const {
+        if (!tablaValida) {
+            throw std::logic_error("Transiciones sin compilar: llamar a compilar()");
+        }
+    }
+
+    void entrarEstado(int estado, int64_t ahoraMs) {
+        estadoActual = estado;
+        entradaEstadoMs = ahoraMs;
+        for (int t = inicioTransiciones[estado]; t < inicioTransiciones[estado + 1]; ++t) {
+            tabla[t].reiniciar();
+        }
+    }
+
+    int idEstado(const std::string& nombre) const {
+        auto it = idsPorNombre.find(nombre);
+        if (it == idsPorNombre.end()) {
+            throw std::invalid_argument("Estado desconocido: " + nombre);
+        }
+        return it->second;
     }
-    
-    ~GrafoEstados() {
-        for (auto& par : estados) {
-            delete par.second;
+
+    // Rearmar la tabla desde las definiciones - O(T log T)
+    // Las condiciones ya vienen compiladas; las filas que ya exist�an
+    // conservan el estado de su filtro y las nuevas arrancan en cero.
+    void compilarTransiciones() {
+        std::vector<int> filaAnterior(definiciones.size(), -1);
+        for (size_t f = 0; f < definicionDeFila.size(); ++f) filaAnterior[definicionDeFila[f]] = (int)f;
+        std::vector<TransicionCompilada> anterior;
+        anterior.swap(tabla);
+
+        std::vector<int> orden(definiciones.size());
+        for (size_t i = 0; i < orden.size(); ++i) orden[i] = (int)i;
+        // Estable: a igual prioridad gana la transici�n cargada primero
+        std::stable_sort(orden.begin(), orden.end(), [this](int a, int b) {
+            if (definiciones[a].first != definiciones[b].first) {
+                return definiciones[a].first < definiciones[b].first;
+            }
+            return definiciones[a].second.prioridad < definiciones[b].second.prioridad;
+        });
+
+        tabla.clear();
+        definicionDeFila.clear();
+        inicioTransiciones.assign(estados.size() + 1, 0);
+        for (int i : orden) {
+            const Transicion& trans = definiciones[i].second;
+            TransicionCompilada fila;
+            fila.predicado = predicadosDefinidos[i];
+            fila.destino = (uint16_t)idEstado(trans.estadoDestino);
+            fila.prioridad = trans.prioridad;
+            fila.histeresis = trans.histeresis;
+            fila.confirmaciones = (uint16_t)trans.confirmaciones;
+            fila.permanenciaMinimaMs = trans.permanenciaMinimaMs;
+            fila.reiniciar();
+            if (filaAnterior[i] >= 0) {
+                fila.ciclosCumplidos = anterior[filaAnterior[i]].ciclosCumplidos;
+                fila.cumplidaAntes = anterior[filaAnterior[i]].cumplidaAntes;
+                fila.retenida = anterior[filaAnterior[i]].retenida;
+            }
+            tabla.push_back(fila);
+            definicionDeFila.push_back(i);
+            inicioTransiciones[definiciones[i].first + 1]++;
+        }
+        for (size_t e = 0; e < estados.size(); ++e) {
+            inicioTransiciones[e + 1] += inicioTransiciones[e];
         }
+        tablaValida = true;
     }
-    
+
+public:
+    // Con construirPorDefecto = false el grafo queda vacio para llenarlo
+    // desde un archivo (ConfiguracionControl)
+    explicit GrafoEstados(bool construirPorDefecto = true)
+        : tablaValida(true), criterioCaminos(CAMINO_SALTOS), caminosValidos(false),
+          estadoActual(0), entradaEstadoMs(-1), transicionesSuprimidas(0), cambiosEstado(0),
+          ultimaEvaluacionMs(-1), historialEstados(MAX_HISTORIAL), version(0) {
+        inicioTransiciones.assign(1, 0);
+        if (construirPorDefecto) {
+            construirGrafo();
+            compilar();
+            estadoActual = idEstado("NORMAL");
+        }
+    }
+
     void construirGrafo() {
         // Estado 1: Normal (operaci�n est�ndar)
-        EstadoInvernadero* normal = new EstadoInvernadero(
-            "NORMAL", "Condiciones �ptimas del invernadero");
-        normal->configuracionActuadores["VENTILADOR"] = 20.0;
-        normal->configuracionActuadores["CALEFACTOR"] = 0.0;
-        normal->configuracionActuadores["RIEGO"] = 30.0;
-        normal->configuracionActuadores["LUZ_LED"] = 50.0;
-        normal->configuracionActuadores["NEBULIZADOR"] = 0.0;
-        estados["NORMAL"] = normal;
-        
+        agregarEstado("NORMAL", "Condiciones �ptimas del invernadero");
+        configurarActuador("NORMAL", ACT_VENTILADOR, 20.0);
+        configurarActuador("NORMAL", ACT_CALEFACTOR, 0.0);
+        configurarActuador("NORMAL", ACT_RIEGO, 30.0);
+        configurarActuador("NORMAL", ACT_LUZ_LED, 50.0);
+        configurarActuador("NORMAL", ACT_NEBULIZADOR, 0.0);
+
         // Estado 2: Calor extremo
-        EstadoInvernadero* calorExtremo = new EstadoInvernadero(
-            "CALOR_EXTREMO", "Temperatura peligrosamente alta");
-        calorExtremo->configuracionActuadores["VENTILADOR"] = 100.0;
-        calorExtremo->configuracionActuadores["CALEFACTOR"] = 0.0;
-        calorExtremo->configuracionActuadores["RIEGO"] = 80.0;
-        calorExtremo->configuracionActuadores["LUZ_LED"] = 0.0;
-        calorExtremo->configuracionActuadores["NEBULIZADOR"] = 100.0;
-        estados["CALOR_EXTREMO"] = calorExtremo;
-        
+        agregarEstado("CALOR_EXTREMO", "Temperatura peligrosamente alta");
+        configurarActuador("CALOR_EXTREMO", ACT_VENTILADOR, 100.0);
+        configurarActuador("CALOR_EXTREMO", ACT_CALEFACTOR, 0.0);
+        configurarActuador("CALOR_EXTREMO", ACT_RIEGO, 80.0);
+        configurarActuador("CALOR_EXTREMO", ACT_LUZ_LED, 0.0);
+        configurarActuador("CALOR_EXTREMO", ACT_NEBULIZADOR, 100.0);
+
         // Estado 3: Fr�o extremo
-        EstadoInvernadero* frioExtremo = new EstadoInvernadero(
-            "FRIO_EXTREMO", "Temperatura peligrosamente baja");
-        frioExtremo->configuracionActuadores["VENTILADOR"] = 0.0;
-        frioExtremo->configuracionActuadores["CALEFACTOR"] = 100.0;
-        frioExtremo->configuracionActuadores["RIEGO"] = 0.0;
-        frioExtremo->configuracionActuadores["LUZ_LED"] = 80.0;
-        frioExtremo->configuracionActuadores["NEBULIZADOR"] = 0.0;
-        estados["FRIO_EXTREMO"] = frioExtremo;
-        
+        agregarEstado("FRIO_EXTREMO", "Temperatura peligrosamente baja");
+        configurarActuador("FRIO_EXTREMO", ACT_VENTILADOR, 0.0);
+        configurarActuador("FRIO_EXTREMO", ACT_CALEFACTOR, 100.0);
+        configurarActuador("FRIO_EXTREMO", ACT_RIEGO, 0.0);
+        configurarActuador("FRIO_EXTREMO", ACT_LUZ_LED, 80.0);
+        configurarActuador("FRIO_EXTREMO", ACT_NEBULIZADOR, 0.0);
+
         // Estado 4: Sequ�a
-        EstadoInvernadero* sequia = new EstadoInvernadero(
-            "SEQUIA", "Humedad del suelo cr�ticamente baja");
-        sequia->configuracionActuadores["VENTILADOR"] = 10.0;
-        sequia->configuracionActuadores["CALEFACTOR"] = 0.0;
-        sequia->configuracionActuadores["RIEGO"] = 100.0;
-        sequia->configuracionActuadores["LUZ_LED"] = 40.0;
-        sequia->configuracionActuadores["NEBULIZADOR"] = 80.0;
-        estados["SEQUIA"] = sequia;
-        
+        agregarEstado("SEQUIA", "Humedad del suelo cr�ticamente baja");
+        configurarActuador("SEQUIA", ACT_VENTILADOR, 10.0);
+        configurarActuador("SEQUIA", ACT_CALEFACTOR, 0.0);
+        configurarActuador("SEQUIA", ACT_RIEGO, 100.0);
+        configurarActuador("SEQUIA", ACT_LUZ_LED, 40.0);
+        configurarActuador("SEQUIA", ACT_NEBULIZADOR, 80.0);
+
         // Estado 5: Humedad excesiva
-        EstadoInvernadero* humedad = new EstadoInvernadero(
-            "HUMEDAD_ALTA", "Humedad excesiva - riesgo de hongos");
-        humedad->configuracionActuadores["VENTILADOR"] = 80.0;
-        humedad->configuracionActuadores["CALEFACTOR"] = 30.0;
-        humedad->configuracionActuadores["RIEGO"] = 0.0;
-        humedad->configuracionActuadores["LUZ_LED"] = 60.0;
-        humedad->configuracionActuadores["NEBULIZADOR"] = 0.0;
-        estados["HUMEDAD_ALTA"] = humedad;
-        
+        agregarEstado("HUMEDAD_ALTA", "Humedad excesiva - riesgo de hongos");
+        configurarActuador("HUMEDAD_ALTA", ACT_VENTILADOR, 80.0);
+        configurarActuador("HUMEDAD_ALTA", ACT_CALEFACTOR, 30.0);
+        configurarActuador("HUMEDAD_ALTA", ACT_RIEGO, 0.0);
+        configurarActuador("HUMEDAD_ALTA", ACT_LUZ_LED, 60.0);
+        configurarActuador("HUMEDAD_ALTA", ACT_NEBULIZADOR, 0.0);
+
         // Estado 6: Recuperaci�n
-        EstadoInvernadero* recuperacion = new EstadoInvernadero(
-            "RECUPERACION", "Retornando a condiciones normales");
-        recuperacion->configuracionActuadores["VENTILADOR"] = 30.0;
-        recuperacion->configuracionActuadores["CALEFACTOR"] = 10.0;
-        recuperacion->configuracionActuadores["RIEGO"] = 40.0;
-        recuperacion->configuracionActuadores["LUZ_LED"] = 50.0;
-        recuperacion->configuracionActuadores["NEBULIZADOR"] = 20.0;
-        estados["RECUPERACION"] = recuperacion;
-        
+        agregarEstado("RECUPERACION", "Retornando a condiciones normales");
+        configurarActuador("RECUPERACION", ACT_VENTILADOR, 30.0);
+        configurarActuador("RECUPERACION", ACT_CALEFACTOR, 10.0);
+        configurarActuador("RECUPERACION", ACT_RIEGO, 40.0);
+        configurarActuador("RECUPERACION", ACT_LUZ_LED, 50.0);
+        configurarActuador("RECUPERACION", ACT_NEBULIZADOR, 20.0);
+
         // Definir transiciones
+        // Las emergencias de temperatura disparan en la primera muestra; el
+        // resto pide confirmaci�n y una banda de hist�resis contra el ruido
         // Desde NORMAL
-        transiciones["NORMAL"].push_back(Transicion("CALOR_EXTREMO", "TEMP>35", 1));
-        transiciones["NORMAL"].push_back(Transicion("FRIO_EXTREMO", "TEMP<15", 1));
-        transiciones["NORMAL"].push_back(Transicion("SEQUIA", "HUM_SUELO<40", 2));
-        transiciones["NORMAL"].push_back(Transicion("HUMEDAD_ALTA", "HUM_REL>85", 2));
-        
+        agregarTransicion("NORMAL", Transicion("CALOR_EXTREMO", "TEMP>35", 1));
+        agregarTransicion("NORMAL", Transicion("FRIO_EXTREMO", "TEMP<15", 1));
+        agregarTransicion("NORMAL", Transicion("SEQUIA", "HUM_SUELO<40", 2, 2.0, 2));
+        agregarTransicion("NORMAL", Transicion("HUMEDAD_ALTA", "HUM_REL>85", 2, 2.0, 2));
+
         // Desde CALOR_EXTREMO
-        transiciones["CALOR_EXTREMO"].push_back(Transicion("RECUPERACION", "TEMP<32", 1));
-        transiciones["CALOR_EXTREMO"].push_back(Transicion("SEQUIA", "HUM_SUELO<30", 2));
-        
+        agregarTransicion("CALOR_EXTREMO", Transicion("RECUPERACION", "TEMP<32", 1, 0.5, 2));
+        agregarTransicion("CALOR_EXTREMO", Transicion("SEQUIA", "HUM_SUELO<30", 2, 2.0, 2));
+
         // Desde FRIO_EXTREMO
-        transiciones["FRIO_EXTREMO"].push_back(Transicion("RECUPERACION", "TEMP>18", 1));
-        
+        agregarTransicion("FRIO_EXTREMO", Transicion("RECUPERACION", "TEMP>18", 1, 0.5, 2));
+
         // Desde SEQUIA
-        transiciones["SEQUIA"].push_back(Transicion("RECUPERACION", "HUM_SUELO>55", 1));
-        transiciones["SEQUIA"].push_back(Transicion("CALOR_EXTREMO", "TEMP>35", 2));
-        
+        agregarTransicion("SEQUIA", Transicion("RECUPERACION", "HUM_SUELO>55", 1, 2.0, 2));
+        agregarTransicion("SEQUIA", Transicion("CALOR_EXTREMO", "TEMP>35", 2));
+
         // Desde HUMEDAD_ALTA
-        transiciones["HUMEDAD_ALTA"].push_back(Transicion("RECUPERACION", "HUM_REL<75", 1));
-        
-        // Desde RECUPERACION
-        transiciones["RECUPERACION"].push_back(Transicion("NORMAL", "TEMP>20", 1));
-    }
-    
-    // Evaluar y cambiar de estado si es necesario
-    std::string evaluarTransiciones(std::map<std::string, double>& sensores) {
-        std::string nuevoEstado = estadoActual;
-        int maxPrioridad = 999;
-        
-        // Buscar transiciones desde estado actual
-        if (transiciones.find(estadoActual) != transiciones.end()) {
-            for (const auto& trans : transiciones[estadoActual]) {
-                if (evaluarCondicionTransicion(trans.condicion, sensores)) {
-                    if (trans.prioridad < maxPrioridad) {
-                        nuevoEstado = trans.estadoDestino;
-                        maxPrioridad = trans.prioridad;
+        agregarTransicion("HUMEDAD_ALTA", Transicion("RECUPERACION", "HUM_REL<75", 1, 2.0, 2));
+
+        // Desde RECUPERACION: volver a NORMAL solo tras estabilizarse
+        agregarTransicion("RECUPERACION", Transicion("NORMAL", "TEMP>20", 1, 0.5, 3, 10000));
+    }
+
+    // Construccion incremental - lanzan invalid_argument si algo no existe
+    void agregarEstado(const std::string& nombre, const std::string& descripcion) {
+        if (idsPorNombre.find(nombre) != idsPorNombre.end()) {
+            throw std::invalid_argument("Estado repetido: " + nombre);
+        }
+        if (estados.size() >= UINT16_MAX) {
+            throw std::length_error("Demasiados estados");
+        }
+        idsPorNombre[nombre] = (int)estados.size();
+        estados.push_back(EstadoInvernadero(nombre, descripcion));
+        inicioTransiciones.push_back(inicioTransiciones.back());
+        permanencias.push_back(PermanenciaEstado());
+        caminosValidos = false;
+    }
+
+    void configurarActuador(const std::string& estado, IdActuador actuador, double intensidad) {
+        EstadoInvernadero& e = estados[idEstado(estado)];
+        e.configuracion.intensidades[actuador] = intensidad;
+        e.configurados |= (uint8_t)(1u << actuador);
+        if (criterioCaminos == CAMINO_ENERGIA) caminosValidos = false;
+    }
+
+    void configurarActuador(const std::string& estado, const std::string& actuador, double intensidad) {
+        int id = buscarActuador(actuador);
+        if (id < 0) {
+            throw std::invalid_argument("Actuador desconocido: " + actuador);
+        }
+        configurarActuador(estado, (IdActuador)id, intensidad);
+    }
+
+    void agregarTransicion(const std::string& origen, const Transicion& transicion) {
+        if (!existeEstado(origen) || !existeEstado(transicion.estadoDestino)) {
+            throw std::invalid_argument("Transicion entre estados desconocidos: " + origen +
+                                        " -> " + transicion.estadoDestino);
+        }
+        Predicado predicado = Predicado::compilar(transicion.condicion); // valida antes de guardar
+        if (!std::isfinite(transicion.histeresis) || transicion.histeresis < 0.0 ||
+            transicion.permanenciaMinimaMs < 0 ||
+            transicion.confirmaciones < 1 || transicion.confirmaciones > UINT16_MAX) {
+            throw std::invalid_argument("Filtro de transicion invalido: " + origen +
+                                        " -> " + transicion.estadoDestino);
+        }
+        // Solo se agrega: la tabla se arma una vez en compilar()
+        definiciones.push_back(std::make_pair(idEstado(origen), transicion));
+        predicadosDefinidos.push_back(predicado);
+        tablaValida = false;
+        caminosValidos = false;
+    }
+
+    // Armar la tabla de transiciones y las de caminos - O(T log T + E^3)
+    // Se llama una vez al terminar de construir o cargar el grafo (o tras
+    // agregar transiciones en ejecuci�n).
+    void compilar() {
+        if (!tablaValida) compilarTransiciones();
+        precalcularCaminos();
+    }
+
+    // Caminos m�nimos entre todos los pares (Floyd-Warshall) - O(V^3) en estados
+    // Las tablas ocupan V^2 double + V^2 uint16_t (10 bytes por par de estados).
+    // La llama compilar() al terminar de construir o cargar el grafo.
+    void precalcularCaminos() {
+        exigirTabla();
+        const double INF = std::numeric_limits<double>::infinity();
+        int n = (int)estados.size();
+        distancias.assign((size_t)n * n, INF);
+        siguienteSalto.assign((size_t)n * n, (uint16_t)SIN_CAMINO);
+
+        for (int e = 0; e < n; ++e) {
+            distancias[(size_t)e * n + e] = 0.0;
+            siguienteSalto[(size_t)e * n + e] = (uint16_t)e;
+            for (int t = inicioTransiciones[e]; t < inicioTransiciones[e + 1]; ++t) {
+                int d = tabla[t].destino;
+                if (d == e) continue;
+                double peso = criterioCaminos == CAMINO_ENERGIA ? costoEnergia(d) : 1.0;
+                if (peso < distancias[(size_t)e * n + d]) {
+                    distancias[(size_t)e * n + d] = peso;
+                    siguienteSalto[(size_t)e * n + d] = (uint16_t)d;
+                }
+            }
+        }
+
+        for (int k = 0; k < n; ++k) {
+            for (int i = 0; i < n; ++i) {
+                double ik = distancias[(size_t)i * n + k];
+                if (ik == INF) continue;
+                for (int j = 0; j < n; ++j) {
+                    double candidato = ik + distancias[(size_t)k * n + j];
+                    if (candidato < distancias[(size_t)i * n + j]) {
+                        distancias[(size_t)i * n + j] = candidato;
+                        siguienteSalto[(size_t)i * n + j] = siguienteSalto[(size_t)i * n + k];
                     }
                 }
             }
         }
-        
-        // Si hay cambio de estado, registrarlo
-        if (nuevoEstado != estadoActual) {
-            historialEstados.push_back(estadoActual);
-            if (historialEstados.size() > 50) {
-                historialEstados.erase(historialEstados.begin());
+        caminosValidos = true;
+    }
+
+    void setCriterioCaminos(CriterioCamino criterio) {
+        criterioCaminos = criterio;
+        compilar();
+    }
+
+    CriterioCamino getCriterioCaminos() const { return criterioCaminos; }
+
+    // Potencia total (kW) de la configuraci�n de un estado - O(A)
+    double costoEnergia(int estado) const {
+        double total = 0.0;
+        for (int a = 0; a < NUM_ACTUADORES; ++a) {
+            total += estados.at(estado).configuracion[a] / 100.0 * potenciaActuador(a);
+        }
+        return total;
+    }
+
+    // Consultas sobre las tablas precalculadas - O(1)
+    bool esAlcanzable(int origen, int destino) const {
+        exigirCaminos();
+        return siguienteSalto[(size_t)origen * estados.size() + destino] != SIN_CAMINO;
+    }
+
+    // Siguiente estado hacia 'destino'; -1 si no se puede llegar
+    int siguienteEstado(int origen, int destino) const {
+        exigirCaminos();
+        uint16_t siguiente = siguienteSalto[(size_t)origen * estados.size() + destino];
+        return siguiente == SIN_CAMINO ? -1 : siguiente;
+    }
+
+    // Saltos o energ�a del camino m�nimo seg�n el criterio; infinito si no hay
+    double costoCamino(int origen, int destino) const {
+        exigirCaminos();
+        return distancias[(size_t)origen * estados.size() + destino];
+    }
+
+    // Estados a los que no se puede llegar desde 'origen' - O(E)
+    std::vector<std::string> estadosInalcanzables(const std::string& origen) const {
+        int id = idEstado(origen);
+        std::vector<std::string> faltantes;
+        for (int e = 0; e < (int)estados.size(); ++e) {
+            if (!esAlcanzable(id, e)) faltantes.push_back(estados[e].nombre);
+        }
+        return faltantes;
+    }
+
+    void setEstadoActual(const std::string& nombre) {
+        entrarEstado(idEstado(nombre), -1);
+    }
+
+    bool existeEstado(const std::string& nombre) const {
+        return idsPorNombre.find(nombre) != idsPorNombre.end();
+    }
+
+    int getCantidadEstados() const { return (int)estados.size(); }
+
+    // true si el estado define la intensidad de todos los actuadores
+    bool configuracionCompleta(const std::string& estado) const {
+        return estados[idEstado(estado)].configurados == (1u << NUM_ACTUADORES) - 1;
+    }
+
+    const ConfiguracionActuadores& getConfiguracion(const std::string& estado) const {
+        return estados[idEstado(estado)].configuracion;
+    }
+
+    void setVersion(int _version) { version = _version; }
+    int getVersion() const { return version; }
+
+    // Escribir el grafo en el formato de ConfiguracionControl - O(E + T)
+    void escribir(std::ostream& salida) const {
+        salida << "FORMATO:GRAFO 1\n";
+        for (const auto& estado : estados) {
+            salida << "ESTADO:" << estado.nombre << "|" << estado.descripcion << "\n";
+            for (int a = 0; a < NUM_ACTUADORES; ++a) {
+                salida << "CONFIG:" << estado.nombre << "|" << nombreActuador(a) << "|"
+                       << estado.configuracion[a] << "\n";
+            }
+        }
+        for (const auto& def : definiciones) {
+            const Transicion& trans = def.second;
+            salida << "TRANSICION:" << estados[def.first].nombre << "|" << trans.estadoDestino << "|"
+                   << trans.condicion << "|" << trans.prioridad;
+            if (trans.tieneFiltros()) {
+                salida << "|" << trans.histeresis << "|" << trans.confirmaciones << "|"
+                       << trans.permanenciaMinimaMs;
+            }
+            salida << "\n";
+        }
+        salida << "INICIAL:" << getEstadoActual() << "\n";
+        salida << "FIN\n";
+    }
+
+    // Evaluar y cambiar de estado si es necesario - O(transiciones del estado)
+    // Todas las filas del estado actualizan su filtro con la muestra; dispara
+    // la primera confirmada en orden de prioridad. No reserva memoria.
+    int evaluarTransiciones(const ValoresControl& sensores, int64_t ahoraMs) {
+        exigirTabla();
+        if (entradaEstadoMs < 0) {
+            entradaEstadoMs = ahoraMs;
+            historialEstados.insertarFinal(CambioEstado((uint16_t)estadoActual, ahoraMs, VAR_TEMP,
+                                                        std::numeric_limits<double>::quiet_NaN()));
+        }
+        ultimaEvaluacionMs = ahoraMs;
+        int64_t permanenciaMs = ahoraMs - entradaEstadoMs;
+
+        int disparo = -1;
+        for (int t = inicioTransiciones[estadoActual]; t < inicioTransiciones[estadoActual + 1]; ++t) {
+            if (tabla[t].actualizar(sensores)) transicionesSuprimidas++;
+            if (disparo >= 0) continue;
+            if (tabla[t].confirmada(permanenciaMs)) {
+                disparo = t;
+            } else if (tabla[t].pendiente()) {
+                tabla[t].retenida = true;
+            }
+        }
+
+        // Si hay cambio de estado, registrarlo (el buffer pisa el m�s antiguo)
+        if (disparo >= 0 && tabla[disparo].destino != estadoActual) {
+            const TransicionCompilada& fila = tabla[disparo];
+            // Las dem�s filas retenidas del estado que se deja ya no disparar�n
+            for (int t = inicioTransiciones[estadoActual]; t < inicioTransiciones[estadoActual + 1]; ++t) {
+                if (t != disparo && tabla[t].retenida) transicionesSuprimidas++;
+                tabla[t].reiniciar();
             }
-            estadoActual = nuevoEstado;
+            registrarSalida(ahoraMs);
+            historialEstados.insertarFinal(CambioEstado(fila.destino, ahoraMs, fila.predicado.variable,
+                                                        sensores[fila.predicado.variable]));
+            cambiosEstado++;
+            entrarEstado(fila.destino, ahoraMs);
         }
-        
+
         return estadoActual;
     }
-    
-    // Obtener configuraci�n del estado actual
-    std::map<std::string, double> getConfiguracionActual() {
-        if (estados.find(estadoActual) != estados.end()) {
-            return estados[estadoActual]->configuracionActuadores;
+
+    std::string evaluarTransiciones(std::map<std::string, double>& sensores, int64_t ahoraMs) {
+        return estados[evaluarTransiciones(ValoresControl::desdeMapa(sensores), ahoraMs)].nombre;
+    }
+
+    // Transiciones que el filtro retuvo y que se abandonaron sin disparar
+    // (la condici�n volvi� atr�s o el estado cambi� por otra fila)
+    long getTransicionesSuprimidas() const { return transicionesSuprimidas; }
+    long getCambiosEstado() const { return cambiosEstado; }
+
+    // Historial de entradas a estados, del m�s antiguo al m�s reciente
+    const BufferCircular<CambioEstado>& getHistorial() const { return historialEstados; }
+
+    const PermanenciaEstado& getPermanencia(int estado) const { return permanencias.at(estado); }
+
+    // Tiempo total en un estado contando la estancia en curso - O(1)
+    int64_t tiempoEnEstadoMs(int estado) const {
+        int64_t total = permanencias.at(estado).totalMs;
+        if (estado == estadoActual && entradaEstadoMs >= 0) {
+            total += ultimaEvaluacionMs - entradaEstadoMs;
         }
-        return std::map<std::string, double>();
+        return total;
     }
-    
-    std::string getEstadoActual() const {
-        return estadoActual;
+
+    // Resumen de permanencia por estado - O(E)
+    void mostrarPermanencias() const {
+        std::cout << "\n  Permanencia por estado (s):\n";
+        std::cout << "  " << std::left << std::setw(15) << "Estado" << std::right
+                  << std::setw(8) << "Visitas" << std::setw(10) << "Total"
+                  << std::setw(10) << "Promedio" << std::setw(10) << "Maximo" << "\n";
+        for (int e = 0; e < (int)estados.size(); ++e) {
+            const PermanenciaEstado& p = permanencias[e];
+            std::cout << "  " << std::left << std::setw(15) << estados[e].nombre << std::right
+                      << std::setw(8) << p.visitas
+                      << std::setw(10) << tiempoEnEstadoMs(e) / 1000.0
+                      << std::setw(10) << p.promedioMs() / 1000.0
+                      << std::setw(10) << p.maximoMs / 1000.0
+                      << (e == estadoActual ? "  (actual)" : "") << "\n";
+        }
     }
-    
+
+    // Obtener configuraci�n del estado actual (sin copiar)
+    const ConfiguracionActuadores& getConfiguracionActual() const {
+        return estados[estadoActual].configuracion;
+    }
+
+    int getIdEstadoActual() const { return estadoActual; }
+
+    const std::string& getNombreEstado(int id) const { return estados.at(id).nombre; }
+
+    const std::string& getEstadoActual() const {
+        return estados.at(estadoActual).nombre;
+    }
+
     std::string getDescripcionEstado() const {
-        if (estados.find(estadoActual) != estados.end()) {
-            return estados.at(estadoActual)->descripcion;
+        if (estadoActual < (int)estados.size()) {
+            return estados[estadoActual].descripcion;
         }
         return "Desconocido";
     }
-    
+
     // Visualizar grafo de estados
-    void mostrarGrafo() {
+    void mostrarGrafo() const {
         std::cout << "\n+----------------------------------------------------+\n";
         std::cout << "�            GRAFO DE ESTADOS DEL SISTEMA           �\n";
         std::cout << "+----------------------------------------------------+\n\n";
-        
-        for (const auto& par : estados) {
-            std::string nombre = par.first;
-            bool esActual = (nombre == estadoActual);
-            
+        exigirTabla();
+
+        for (int e = 0; e < (int)estados.size(); ++e) {
+            bool esActual = (e == estadoActual);
+
             std::cout << (esActual ? " " : "  ");
-            std::cout << "[" << nombre << "] ";
-            std::cout << par.second->descripcion << "\n";
-            
-            // Mostrar transiciones salientes
-            if (transiciones.find(nombre) != transiciones.end()) {
-                for (const auto& trans : transiciones[nombre]) {
-                    std::cout << "    +- " << trans.estadoDestino 
-                             << " si [" << trans.condicion << "]\n";
+            std::cout << "[" << estados[e].nombre << "] ";
+            std::cout << estados[e].descripcion << "\n";
+
+            // Mostrar transiciones salientes (en orden de prioridad)
+            for (int t = inicioTransiciones[e]; t < inicioTransiciones[e + 1]; ++t) {
+                const Transicion& trans = definiciones[definicionDeFila[t]].second;
+                std::cout << "    +- " << trans.estadoDestino
+                         << " si [" << trans.condicion << "]";
+                if (trans.tieneFiltros()) {
+                    std::cout << " (banda " << trans.histeresis << ", " << trans.confirmaciones
+                             << " ciclos, " << trans.permanenciaMinimaMs / 1000.0 << " s)";
                 }
+                std::cout << "\n";
             }
             std::cout << "\n";
         }
+
+        if (!caminosValidos) return;
+        std::cout << "  Transiciones m�nimas (fila: origen, columna: destino)\n";
+        std::cout << "  " << std::setw(15) << "";
+        for (int d = 0; d < (int)estados.size(); ++d) std::cout << std::setw(4) << d;
+        std::cout << "\n";
+        for (int o = 0; o < (int)estados.size(); ++o) {
+            std::cout << "  " << std::setw(2) << o << " " << std::left << std::setw(12)
+                     << estados[o].nombre.substr(0, 12) << std::right;
+            for (int d = 0; d < (int)estados.size(); ++d) {
+                if (!esAlcanzable(o, d)) {
+                    std::cout << std::setw(4) << "-";
+                } else {
+                    // Contar saltos siguiendo la tabla (vale para ambos criterios)
+                    int saltos = 0;
+                    for (int e = o; e != d; e = siguienteEstado(e, d)) saltos++;
+                    std::cout << std::setw(4) << saltos;
+                }
+            }
+            std::cout << "\n";
+        }
+        std::cout << "\n";
     }
-    
+
     // Mostrar estado actual con detalle visual
-    void mostrarEstadoActual() {
+    void mostrarEstadoActual() const {
         std::cout << "\n+----------------------------------------------------+\n";
         std::cout << "�              ESTADO ACTUAL DEL SISTEMA            �\n";
         std::cout << "+----------------------------------------------------+\n";
-        
-        std::cout << "\n  Estado: " << estadoActual << "\n";
+
+        std::cout << "\n  Estado: " << getEstadoActual() << "\n";
         std::cout << "  Descripci�n: " << getDescripcionEstado() << "\n\n";
-        
+
         std::cout << "+--- CONFIGURACI�N DE ACTUADORES -------------------+\n";
-        auto config = getConfiguracionActual();
-        for (const auto& par : config) {
-            std::cout << "� " << std::left << std::setw(15) << par.first 
-                     << ": " << std::right << std::setw(6) << (int)par.second << "%  ";
-            
+        const ConfiguracionActuadores& config = getConfiguracionActual();
+        for (int a = 0; a < NUM_ACTUADORES; ++a) {
+            std::cout << "� " << std::left << std::setw(15) << nombreActuador(a)
+                     << ": " << std::right << std::setw(6) << (int)config[a] << "%  ";
+
             // Barra visual
-            int barras = static_cast<int>(par.second / 10);
+            int barras = static_cast<int>(config[a] / 10);
             std::cout << "[";
             for (int i = 0; i < 10; ++i) {
                 std::cout << (i < barras ? "" : "");
@@ -258,50 +712,45 @@ public:
             std::cout << "]\n";
         }
         std::cout << "+---------------------------------------------------+\n";
-        
-        // Historial reciente
-        if (!historialEstados.empty()) {
+        std::cout << "  Cambios de estado: " << cambiosEstado
+                  << " | Transiciones suprimidas: " << transicionesSuprimidas << "\n";
+
+        // Historial reciente (termina en el estado actual)
+        if (!historialEstados.estaVacia()) {
             std::cout << "\nHistorial reciente: ";
-            int mostrar = std::min(5, (int)historialEstados.size());
-            for (int i = historialEstados.size() - mostrar; i < (int)historialEstados.size(); ++i) {
-                std::cout << historialEstados[i];
-                if (i < (int)historialEstados.size() - 1) std::cout << "  ";
+            int tamano = historialEstados.getTamano();
+            int mostrar = std::min(6, tamano);
+            for (int i = tamano - mostrar; i < tamano; ++i) {
+                std::cout << estados[historialEstados.obtener(i).estado].nombre;
+                if (i < tamano - 1) std::cout << "  ";
             }
-            std::cout << "  " << estadoActual << "\n";
-        }
-    }
-    
-    // Buscar camino m�s corto entre dos estados (BFS)
-    std::vector<std::string> encontrarCamino(std::string origen, std::string destino) {
-        std::queue<std::vector<std::string>> cola;
-        std::set<std::string> visitados;
-        
-        cola.push({origen});
-        visitados.insert(origen);
-        
-        while (!cola.empty()) {
-            std::vector<std::string> camino = cola.front();
-            cola.pop();
-            
-            std::string actual = camino.back();
-            
-            if (actual == destino) {
-                return camino;
-            }
-            
-            if (transiciones.find(actual) != transiciones.end()) {
-                for (const auto& trans : transiciones[actual]) {
-                    if (visitados.find(trans.estadoDestino) == visitados.end()) {
-                        std::vector<std::string> nuevoCamino = camino;
-                        nuevoCamino.push_back(trans.estadoDestino);
-                        cola.push(nuevoCamino);
-                        visitados.insert(trans.estadoDestino);
-                    }
-                }
+            const CambioEstado& ultimo = historialEstados.ultimo();
+            if (!std::isnan(ultimo.valorDisparo)) {
+                std::cout << " (" << nombreVariable(ultimo.variable) << "=" << ultimo.valorDisparo << ")";
             }
+            std::cout << "\n";
+        }
+    }
+
+    // Camino m�nimo entre dos estados siguiendo la tabla precalculada
+    // O(longitud del camino); vac�o si no existe alguno de los estados o no hay camino
+    std::vector<std::string> encontrarCamino(const std::string& origen, const std::string& destino) const {
+        std::vector<std::string> camino;
+        if (!existeEstado(origen) || !existeEstado(destino)) {
+            return camino;
+        }
+        int actual = idEstado(origen);
+        int idDestino = idEstado(destino);
+        if (!esAlcanzable(actual, idDestino)) {
+            return camino;
+        }
+
+        camino.push_back(estados[actual].nombre);
+        while (actual != idDestino) {
+            actual = siguienteEstado(actual, idDestino);
+            camino.push_back(estados[actual].nombre);
         }
-        
-        return std::vector<std::string>(); // No hay camino
+        return camino;
     }
 };
 
@@ -0,0 +1,200 @@
+#ifndef HEAP_INDEXADO_HPP
+#define HEAP_INDEXADO_HPP
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Min-Heap d-ario indexado por clave (menor valor = mayor prioridad)
+// Cada clave aparece a lo sumo una vez: insertar una clave existente la
+// actualiza en su lugar. El mapa de claves guarda la posicion de cada
+// entrada en el arreglo, asi que actualizar/eliminar por clave es O(log n).
+template <typename Clave, typename T, int Aridad = 4>
+class HeapIndexado {
+private:
+    typedef std::map<Clave, int> MapaPosiciones;
+
+    struct Entrada {
+        T dato;
+        typename MapaPosiciones::iterator enlace; // clave y posicion actual
+    };
+
+    std::vector<Entrada> heap;
+    MapaPosiciones posiciones;
+
+    // Obtener indice del padre - O(1)
+    static int padre(int i) { return (i - 1) / Aridad; }
+
+    // Obtener indice del primer hijo - O(1)
+    static int primerHijo(int i) { return Aridad * i + 1; }
+
+    // Mover entrada a la posicion i y registrar su nueva posicion - O(1)
+    void colocar(int i, Entrada&& entrada) {
+        heap[i] = std::move(entrada);
+        heap[i].enlace->second = i;
+    }
+
+    // Subir usando un hueco en vez de intercambios - O(log n)
+    int subir(int i) {
+        if (i == 0 || !(heap[i].dato < heap[padre(i)].dato)) return i;
+        Entrada movida = std::move(heap[i]);
+        while (i > 0 && movida.dato < heap[padre(i)].dato) {
+            colocar(i, std::move(heap[padre(i)]));
+            i = padre(i);
+        }
+        colocar(i, std::move(movida));
+        return i;
+    }
+
+    // Bajar iterativamente hacia el menor de los Aridad hijos - O(d log n / log d)
+    void bajar(int i) {
+        int n = heap.size();
+        Entrada movida = std::move(heap[i]);
+        while (true) {
+            int hijo = primerHijo(i);
+            if (hijo >= n) break;
+            int menor = hijo;
+            int fin = std::min(hijo + Aridad, n);
+            for (int j = hijo + 1; j < fin; j++) {
+                if (heap[j].dato < heap[menor].dato) menor = j;
+            }
+            if (!(heap[menor].dato < movida.dato)) break;
+            colocar(i, std::move(heap[menor]));
+            i = menor;
+        }
+        colocar(i, std::move(movida));
+    }
+
+    // Restaurar la propiedad de heap tras modificar la entrada i - O(log n)
+    void reubicar(int i) {
+        if (subir(i) == i) bajar(i);
+    }
+
+    // Quitar la entrada en la posicion i - O(log n)
+    void quitar(int i) {
+        posiciones.erase(heap[i].enlace);
+        int ultimo = heap.size() - 1;
+        if (i != ultimo) {
+            colocar(i, std::move(heap[ultimo]));
+            heap.pop_back();
+            reubicar(i);
+        } else {
+            heap.pop_back();
+        }
+    }
+
+public:
+    HeapIndexado() {}
+
+    // Insertar, o reemplazar el dato si la clave ya existe - O(log n)
+    // Retorna true si la clave era nueva
+    bool insertarOActualizar(const Clave& clave, T dato) {
+        auto resultado = posiciones.insert(std::make_pair(clave, (int)heap.size()));
+        if (!resultado.second) {
+            int i = resultado.first->second;
+            heap[i].dato = std::move(dato);
+            reubicar(i);
+            return false;
+        }
+        Entrada entrada;
+        entrada.dato = std::move(dato);
+        entrada.enlace = resultado.first;
+        heap.push_back(std::move(entrada));
+        subir(heap.size() - 1);
+        return true;
+    }
+
+    // Modificar en su lugar el dato de una clave (p. ej. escalar prioridad) - O(log n)
+    template <typename Func>
+    bool modificar(const Clave& clave, Func funcion) {
+        auto it = posiciones.find(clave);
+        if (it == posiciones.end()) return false;
+        int i = it->second;
+        funcion(heap[i].dato);
+        reubicar(i);
+        return true;
+    }
+
+    // Eliminar por clave - O(log n)
+    bool eliminar(const Clave& clave) {
+        auto it = posiciones.find(clave);
+        if (it == posiciones.end()) return false;
+        quitar(it->second);
+        return true;
+    }
+
+    bool contiene(const Clave& clave) const {
+        return posiciones.find(clave) != posiciones.end();
+    }
+
+    // Dato asociado a una clave, o nullptr - O(log n)
+    const T* buscar(const Clave& clave) const {
+        auto it = posiciones.find(clave);
+        return it != posiciones.end() ? &heap[it->second].dato : nullptr;
+    }
+
+    // Extraer minimo (mayor prioridad) - O(log n)
+    T extraerMin() {
+        if (estaVacio()) {
+            throw std::runtime_error("Heap vacio");
+        }
+        T minimo = std::move(heap[0].dato);
+        quitar(0);
+        return minimo;
+    }
+
+    // Ver minimo sin extraer - O(1)
+    const T& verMin() const {
+        if (estaVacio()) {
+            throw std::runtime_error("Heap vacio");
+        }
+        return heap[0].dato;
+    }
+
+    // Ver los k primeros en orden sin modificar ni copiar el heap - O(k^2 * Aridad)
+    // Explora el heap desde la raiz con una frontera de indices candidatos;
+    // pensado para k pequeno (vistas de estado), no para ordenar todo el heap.
+    std::vector<const T*> verPrimeros(int k) const {
+        std::vector<const T*> resultado;
+        if (k <= 0 || estaVacio()) return resultado;
+        resultado.reserve(k);
+
+        std::vector<int> frontera;
+        frontera.push_back(0);
+        while (!frontera.empty() && (int)resultado.size() < k) {
+            // La frontera es pequena (<= k * Aridad): busqueda lineal del menor
+            size_t menor = 0;
+            for (size_t j = 1; j < frontera.size(); j++) {
+                if (heap[frontera[j]].dato < heap[frontera[menor]].dato) menor = j;
+            }
+            int i = frontera[menor];
+            frontera[menor] = frontera.back();
+            frontera.pop_back();
+
+            resultado.push_back(&heap[i].dato);
+            int hijo = primerHijo(i);
+            int fin = std::min(hijo + Aridad, (int)heap.size());
+            for (int j = hijo; j < fin; j++) {
+                frontera.push_back(j);
+            }
+        }
+        return resultado;
+    }
+
+    bool estaVacio() const {
+        return heap.empty();
+    }
+
+    int getTamano() const {
+        return heap.size();
+    }
+
+    void limpiar() {
+        heap.clear();
+        posiciones.clear();
+    }
+};
+
+#endif
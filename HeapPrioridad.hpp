@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <stdexcept>
+#include <utility>
 
 // Min-Heap para cola de prioridad (menor valor = mayor prioridad)
 template <typename T>
@@ -20,49 +21,71 @@ private:
     int hijoDer(int i) { return 2 * i + 2; }
 
     // HeapifyUp: restaurar propiedad de heap hacia arriba - O(log n)
+    // Desplaza los padres hacia un hueco y coloca el elemento una sola vez
     void heapifyUp(int i) {
-        while (i > 0 && heap[i] < heap[padre(i)]) {
-            std::swap(heap[i], heap[padre(i)]);
+        if (i == 0 || !(heap[i] < heap[padre(i)])) return;
+        T movido = std::move(heap[i]);
+        while (i > 0 && movido < heap[padre(i)]) {
+            heap[i] = std::move(heap[padre(i)]);
             i = padre(i);
         }
+        heap[i] = std::move(movido);
     }
 
     // HeapifyDown: restaurar propiedad de heap hacia abajo - O(log n)
+    // Iterativo, con hueco en lugar de intercambios
     void heapifyDown(int i) {
-        int menor = i;
-        int izq = hijoIzq(i);
-        int der = hijoDer(i);
-
-        if (izq < (int)heap.size() && heap[izq] < heap[menor]) {
-            menor = izq;
-        }
-        if (der < (int)heap.size() && heap[der] < heap[menor]) {
-            menor = der;
-        }
-
-        if (menor != i) {
-            std::swap(heap[i], heap[menor]);
-            heapifyDown(menor);
+        int n = heap.size();
+        T movido = std::move(heap[i]);
+        while (true) {
+            int menor = hijoIzq(i);
+            if (menor >= n) break;
+            int der = hijoDer(i);
+            if (der < n && heap[der] < heap[menor]) {
+                menor = der;
+            }
+            if (!(heap[menor] < movido)) break;
+            heap[i] = std::move(heap[menor]);
+            i = menor;
         }
+        heap[i] = std::move(movido);
     }
 
 public:
+    // Iteracion de solo lectura en orden de heap (no ordenado)
+    typedef typename std::vector<T>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
     HeapPrioridad() {}
 
     // Insertar elemento - O(log n)
-    void insertar(T elemento) {
+    void insertar(const T& elemento) {
         heap.push_back(elemento);
         heapifyUp(heap.size() - 1);
     }
 
+    void insertar(T&& elemento) {
+        heap.push_back(std::move(elemento));
+        heapifyUp(heap.size() - 1);
+    }
+
+    // Construir el elemento al final del arreglo y subirlo - O(log n)
+    template <typename... Args>
+    void emplazar(Args&&... args) {
+        heap.emplace_back(std::forward<Args>(args)...);
+        heapifyUp(heap.size() - 1);
+    }
+
     // Extraer m�nimo (mayor prioridad) - O(log n)
     T extraerMin() {
         if (estaVacio()) {
             throw std::runtime_error("Heap vacio");
         }
 
-        T minimo = heap[0];
-        heap[0] = heap.back();
+        T minimo = std::move(heap[0]);
+        if (heap.size() > 1) {
+            heap[0] = std::move(heap.back());
+        }
         heap.pop_back();
 
         if (!estaVacio()) {
@@ -73,7 +96,7 @@ public:
     }
 
     // Ver m�nimo sin extraer - O(1)
-    T verMin() const {
+    const T& verMin() const {
         if (estaVacio()) {
             throw std::runtime_error("Heap vacio");
         }
@@ -93,12 +116,22 @@ public:
     }
 
     // Construir heap desde vector - O(n)
-    void construirHeap(std::vector<T>& elementos) {
+    void construirHeap(const std::vector<T>& elementos) {
         heap = elementos;
         for (int i = heap.size() / 2 - 1; i >= 0; i--) {
             heapifyDown(i);
         }
     }
+
+    void construirHeap(std::vector<T>&& elementos) {
+        heap = std::move(elementos);
+        for (int i = heap.size() / 2 - 1; i >= 0; i--) {
+            heapifyDown(i);
+        }
+    }
+
+    const_iterator begin() const { return heap.begin(); }
+    const_iterator end() const { return heap.end(); }
 };
 
 #endif
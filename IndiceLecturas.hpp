@@ -0,0 +1,136 @@
+#ifndef INDICE_LECTURAS_HPP
+#define INDICE_LECTURAS_HPP
+
+#include "ArbolAVL.hpp"
+#include "Lectura.hpp"
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+// Indice de lecturas por clave compuesta (tiempoMs, sensor, secuencia)
+// Ademas del arbol principal mantiene un AVL secundario por sensor, ordenado
+// por (tiempoMs, secuencia), para consultas por sensor en O(log n + k).
+// Los arboles por sensor se ubican directamente por el id internado.
+class IndiceLecturas {
+private:
+    typedef ArbolAVL<Lectura, PoolNodos> ArbolLecturas;
+
+    ArbolLecturas principal;
+    std::vector<ArbolLecturas*> porSensor; // indexado por id de sensor
+
+    // Ninguna lectura real usa el id SIN_SENSOR, asi que (ms, 0, 0)
+    // precede a todas las lecturas del milisegundo ms
+    static Lectura cota(long long ms) {
+        return Lectura(ms, 0, RegistroSensores::SIN_SENSOR, 0.0);
+    }
+
+    // (ms, ultimo sensor, ultima secuencia) sigue a todas las lecturas del
+    // milisegundo ms: cota superior inclusiva sin calcular ms + 1
+    static Lectura cotaSuperior(long long ms) {
+        return Lectura(ms, UINT8_MAX, UINT16_MAX, 0.0);
+    }
+
+    // Cotas [desde, hasta] dentro del arbol de un solo sensor
+    static Lectura cotaSensorInferior(uint16_t sensor, long long ms) {
+        return Lectura(ms, 0, sensor, 0.0);
+    }
+
+    static Lectura cotaSensorSuperior(uint16_t sensor, long long ms) {
+        return Lectura(ms, UINT8_MAX, sensor, 0.0);
+    }
+
+    const ArbolLecturas* arbolSensor(uint16_t sensor) const {
+        return sensor < porSensor.size() ? porSensor[sensor] : nullptr;
+    }
+
+public:
+    IndiceLecturas() {}
+
+    IndiceLecturas(const IndiceLecturas&) = delete;
+    IndiceLecturas& operator=(const IndiceLecturas&) = delete;
+
+    ~IndiceLecturas() {
+        for (ArbolLecturas* arbol : porSensor) {
+            delete arbol;
+        }
+    }
+
+    // Insertar lectura en el indice principal y en el de su sensor - O(log n)
+    bool insertar(const Lectura& lectura) {
+        if (!principal.insertar(lectura)) return false;
+        if (lectura.sensor >= porSensor.size()) {
+            porSensor.resize(lectura.sensor + 1, nullptr);
+        }
+        ArbolLecturas*& arbol = porSensor[lectura.sensor];
+        if (!arbol) arbol = new ArbolLecturas();
+        arbol->insertar(lectura);
+        return true;
+    }
+
+    // Retencion: eliminar lecturas con tiempoMs < limiteMs - O(k log n)
+    int eliminarAnteriores(long long limiteMs) {
+        int eliminadas = principal.eliminarRango(cota(LLONG_MIN), cota(limiteMs));
+        if (eliminadas > 0) {
+            for (size_t id = 0; id < porSensor.size(); id++) {
+                if (!porSensor[id]) continue;
+                porSensor[id]->eliminarRango(cotaSensorInferior((uint16_t)id, LLONG_MIN),
+                                             cotaSensorSuperior((uint16_t)id, limiteMs - 1));
+            }
+        }
+        return eliminadas;
+    }
+
+    // Todas las lecturas con tiempoMs en [desdeMs, hastaMs] - O(log n + k)
+    std::vector<Lectura> buscarRango(long long desdeMs, long long hastaMs) const {
+        return principal.buscarRango(cota(desdeMs), cotaSuperior(hastaMs));
+    }
+
+    // Lecturas de un sensor con tiempoMs en [desdeMs, hastaMs] - O(log n + k)
+    std::vector<Lectura> buscarRangoSensor(uint16_t sensor,
+                                           long long desdeMs, long long hastaMs) const {
+        const ArbolLecturas* arbol = arbolSensor(sensor);
+        if (!arbol) return std::vector<Lectura>();
+        return arbol->buscarRango(cotaSensorInferior(sensor, desdeMs), cotaSensorSuperior(sensor, hastaMs));
+    }
+
+    // Visitar en orden las lecturas de un sensor sin copiarlas - O(log n + k)
+    template <typename Func>
+    void recorrerSensor(uint16_t sensor, long long desdeMs, long long hastaMs,
+                        Func funcion) const {
+        const ArbolLecturas* arbol = arbolSensor(sensor);
+        if (arbol) {
+            arbol->recorrerRango(cotaSensorInferior(sensor, desdeMs),
+                                 cotaSensorSuperior(sensor, hastaMs), funcion);
+        }
+    }
+
+    // Visitar en orden todas las lecturas retenidas de un sensor - O(k)
+    template <typename Func>
+    void recorrerSensor(uint16_t sensor, Func funcion) const {
+        recorrerSensor(sensor, LLONG_MIN, LLONG_MAX, funcion);
+    }
+
+    // Cantidad, promedio y extremos de un sensor en [desdeMs, hastaMs] - O(log n)
+    ResumenRango resumenRangoSensor(uint16_t sensor,
+                                    long long desdeMs, long long hastaMs) const {
+        const ArbolLecturas* arbol = arbolSensor(sensor);
+        if (!arbol) return ResumenRango();
+        return arbol->resumenRango(cotaSensorInferior(sensor, desdeMs), cotaSensorSuperior(sensor, hastaMs));
+    }
+
+    // Resumen de todas las lecturas retenidas de un sensor - O(1)
+    ResumenRango resumenSensor(uint16_t sensor) const {
+        const ArbolLecturas* arbol = arbolSensor(sensor);
+        return arbol ? arbol->resumenTotal() : ResumenRango();
+    }
+
+    int getTamano() const { return principal.getTamano(); }
+    int getAltura() const { return principal.getAltura(); }
+
+    int getTamanoSensor(uint16_t sensor) const {
+        const ArbolLecturas* arbol = arbolSensor(sensor);
+        return arbol ? arbol->getTamano() : 0;
+    }
+};
+
+#endif
@@ -8,19 +8,26 @@
 #include "ArbolDecision.hpp"
 #include "Grafo.hpp"
 #include "ListaEnlazada.hpp"
-#include "ListaDoble.hpp"
+#include "BufferCircular.hpp"
 #include "Pila.hpp"
-#include "Cola.hpp"
-#include "HeapPrioridad.hpp"
+#include "ColaSPSC.hpp"
+#include "ColaMPMC.hpp"
+#include "HeapIndexado.hpp"
 #include "ArbolAVL.hpp"
+#include "IndiceLecturas.hpp"
 #include "Estadisticas.hpp"
 #include "SistemaGameplay.hpp"  // Incluir el sistema de gamificación
 #include "GestorPartidas.hpp"
 #include "ControlActuadores.hpp"
+#include "ConfiguracionControl.hpp"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <map>
+#include <utility>
+#include <memory>
+#include <algorithm>
+#include <climits>
 
 class Invernadero {
 private:
@@ -32,6 +39,8 @@ private:
     SensorPH* sensorPH;
     SensorCO2* sensorCO2;
     SensorNivelAgua* sensorAgua;
+    // Vista uniforme (adaptadores) para operaciones sobre todos los sensores
+    std::vector<Sensor*> sensores;
 
     // Actuadores
     Ventilador* ventilador;
@@ -41,21 +50,48 @@ private:
     Nebulizador* nebulizador;
 
     // Sistema de control inteligente
-    ArbolDecision* arbolControl;
-    GrafoEstados* grafoEstados;
+    // Se reemplazan enteros al recargar la configuracion (RCU): el ciclo toma
+    // su referencia con atomic_load y la version vieja se libera cuando el
+    // ultimo lector la suelta, sin pausar el control
+    std::shared_ptr<ArbolDecision> arbolControl;
+    std::shared_ptr<GrafoEstados> grafoEstados;
+    // El grafo tiene estado mutable (estado actual, filtros) que solo escribe
+    // el ciclo: un grafo recargado espera aqui y el ciclo lo adopta al empezar,
+    // trasladando el estado actual sin carreras con evaluarTransiciones
+    std::shared_ptr<GrafoEstados> grafoPendiente;
 
     // Estructuras de datos
-    ListaDoble<Lectura>* historialLecturas;
-    HeapPrioridad<Alarma>* colaAlarmas;
-    ArbolAVL<Lectura>* indiceTimestamp;
-    Pila<std::string>* pilaConfiguraciones;
-    Cola<std::string>* colaComandos;
-    ListaEnlazada<Alarma>* logAlarmas;
+    BufferCircular<Lectura>* historialLecturas;
+    // Alarmas activas indexadas por (sensorID, tipo): una entrada por condicion
+    typedef std::pair<std::string, std::string> ClaveAlarma;
+    HeapIndexado<ClaveAlarma, Alarma>* colaAlarmas;
+    IndiceLecturas* indiceLecturas;
+    // Estadisticas acumuladas desde el inicio (momentos y cuantiles),
+    // indexadas por id de sensor
+    std::vector<EstadisticasFlujo> estadisticasFlujo;
+    // Senales de los ultimos minutos (media, extremos, tendencia), por id de sensor
+    std::vector<SenalesVentana> senales;
+    Pila<std::string, PoolNodos>* pilaConfiguraciones;
+    // Comandos de actuadores: un productor (interfaz) y un consumidor (ciclo de control)
+    ColaSPSCBloqueante<ComandoActuador, 64>* colaComandos;
+    // Ingesta de lecturas: varios hilos lectores publican lotes, el ciclo los drena
+    ColaMPMC<Lectura>* colaIngesta;
+    ListaEnlazada<Alarma, PoolNodos>* logAlarmas;
 
     // Configuración
+    static const int CAPACIDAD_INGESTA = 1024;
+    static const int TAMANO_LOTE_INGESTA = 32;
     int maxLecturas;
     bool modoAutomatico;
     int ciclosSimulacion;
+    // Desempate por sensor: ultimo milisegundo visto y siguiente secuencia
+    struct SecuenciaSensor {
+        long long tiempoMs;
+        int siguiente;
+    };
+    std::vector<SecuenciaSensor> secuencias; // indexado por id de sensor
+    long lecturasRechazadas;                 // claves repetidas que el indice no acepto
+    const Reloj* reloj; // marca de tiempo de las lecturas (inyectable)
     std::string modoControl; // "ARBOL" o "GRAFO"
 
     // Sistemas de gamificación
@@ -71,7 +107,8 @@ private:
 
 public:
     Invernadero() : maxLecturas(1000), modoAutomatico(true), 
-                    ciclosSimulacion(0), modoControl("ARBOL"),
+                    ciclosSimulacion(0), lecturasRechazadas(0),
+                    reloj(&RelojSistema::global()), modoControl("ARBOL"),
                     calidadPromedio(100.0), ciclosExitosos(0), 
                     totalAlarmasEvitadas(0) {
         // Inicializar sensores
@@ -82,6 +119,13 @@ public:
         sensorPH = new SensorPH("PH", 6.5);
         sensorCO2 = new SensorCO2("CO2", 450.0);
         sensorAgua = new SensorNivelAgua("AGUA", 500.0);
+        sensores.push_back(adaptarSensor(sensorTempAmb));
+        sensores.push_back(adaptarSensor(sensorHumRel));
+        sensores.push_back(adaptarSensor(sensorHumSuelo));
+        sensores.push_back(adaptarSensor(sensorLuz));
+        sensores.push_back(adaptarSensor(sensorPH));
+        sensores.push_back(adaptarSensor(sensorCO2));
+        sensores.push_back(adaptarSensor(sensorAgua));
 
         // Inicializar actuadores
         ventilador = new Ventilador("VENT_01");
@@ -91,16 +135,18 @@ public:
         nebulizador = new Nebulizador("NEB_01");
 
         // Inicializar sistemas de control inteligente
-        arbolControl = new ArbolDecision();
-        grafoEstados = new GrafoEstados();
+        arbolControl = std::make_shared<ArbolDecision>();
+        arbolControl->setTrazado(true); // el ciclo interactivo muestra el camino
+        grafoEstados = std::make_shared<GrafoEstados>();
 
         // Inicializar estructuras de datos
-        historialLecturas = new ListaDoble<Lectura>();
-        colaAlarmas = new HeapPrioridad<Alarma>();
-        indiceTimestamp = new ArbolAVL<Lectura>();
-        pilaConfiguraciones = new Pila<std::string>();
-        colaComandos = new Cola<std::string>();
-        logAlarmas = new ListaEnlazada<Alarma>();
+        historialLecturas = new BufferCircular<Lectura>(maxLecturas);
+        colaAlarmas = new HeapIndexado<ClaveAlarma, Alarma>();
+        indiceLecturas = new IndiceLecturas();
+        pilaConfiguraciones = new Pila<std::string, PoolNodos>();
+        colaComandos = new ColaSPSCBloqueante<ComandoActuador, 64>(BLOQUEAR);
+        colaIngesta = new ColaMPMC<Lectura>(CAPACIDAD_INGESTA);
+        logAlarmas = new ListaEnlazada<Alarma, PoolNodos>();
 
         sistemaGameplay = new SistemaGameplay();
         controlActuadores = new ControlActuadores();
@@ -109,6 +155,7 @@ public:
     }
 
     ~Invernadero() {
+        for (Sensor* sensor : sensores) delete sensor;
         delete sensorTempAmb;
         delete sensorHumRel;
         delete sensorHumSuelo;
@@ -121,13 +168,12 @@ public:
         delete riego;
         delete luzLED;
         delete nebulizador;
-        delete arbolControl;
-        delete grafoEstados;
         delete historialLecturas;
         delete colaAlarmas;
-        delete indiceTimestamp;
+        delete indiceLecturas;
         delete pilaConfiguraciones;
         delete colaComandos;
+        delete colaIngesta;
         delete logAlarmas;
         delete sistemaGameplay;
         delete controlActuadores;
@@ -141,9 +187,16 @@ public:
         std::cout << "¦         CICLO DE CONTROL #" << std::setw(4) << ciclosSimulacion << "                    ¦\n";
         std::cout << "+----------------------------------------------------+\n";
 
+        // Aplicar comandos publicados por la interfaz desde el ultimo ciclo
+        int comandos = procesarComandos();
+        if (comandos > 0) {
+            std::cout << "\n   Comandos manuales aplicados: " << comandos << "\n";
+        }
+        adoptarGrafoPendiente();
+
         // 1. Leer todos los sensores
         std::cout << "\n[1/5]  Leyendo sensores...\n";
-        time_t ahora = time(nullptr);
+        long long ahoraMs = reloj->ahoraMs();
         double tempAmb = sensorTempAmb->leer();
         double humRel = sensorHumRel->leer();
         double humSuelo = sensorHumSuelo->leer();
@@ -159,20 +212,32 @@ public:
 
         // 2. Almacenar lecturas
         std::cout << "\n[2/5]  Almacenando datos...\n";
-        Lectura lecTemp(ahora, "TEMP", tempAmb, sensorTempAmb->evaluarEstado());
-        Lectura lecHumSuelo(ahora, "HUM_SUELO", humSuelo, sensorHumSuelo->evaluarEstado());
-        Lectura lecHumRel(ahora, "HUM_REL", humRel, sensorHumRel->evaluarEstado());
-        
-        historialLecturas->insertarFinal(lecTemp);
-        historialLecturas->insertarFinal(lecHumSuelo);
-        historialLecturas->insertarFinal(lecHumRel);
-        indiceTimestamp->insertar(lecTemp);
-
-        if (historialLecturas->getTamano() > maxLecturas) {
-            historialLecturas->eliminarInicio();
+        // Las lecturas propias entran por la misma cola que las de hilos externos
+        Lectura lote[3] = {
+            Lectura(ahoraMs, 0, sensorTempAmb->getIdInterno(), tempAmb, sensorTempAmb->evaluarEstado()),
+            Lectura(ahoraMs, 0, sensorHumSuelo->getIdInterno(), humSuelo, sensorHumSuelo->evaluarEstado()),
+            Lectura(ahoraMs, 0, sensorHumRel->getIdInterno(), humRel, sensorHumRel->evaluarEstado())
+        };
+        int publicadas = 0;
+        while (publicadas < 3) {
+            publicadas += publicarLecturas(lote + publicadas, 3 - publicadas);
+            if (publicadas < 3) drenarIngesta(); // cola llena: hacer espacio
         }
+        drenarIngesta();
 
-        std::cout << "   Lecturas almacenadas: " << historialLecturas->getTamano() << "\n";
+        std::cout << "   Lecturas almacenadas: " << historialLecturas->getTamano();
+        if (lecturasRechazadas > 0) std::cout << " (rechazadas: " << lecturasRechazadas << ")";
+        std::cout << "\n";
+
+        const SenalesVentana* senalTemp = getSenales(sensorTempAmb->getIdInterno());
+        const SenalesVentana* senalHumSuelo = getSenales(sensorHumSuelo->getIdInterno());
+        const SenalesVentana* senalHumRel = getSenales(sensorHumRel->getIdInterno());
+        if (senalTemp) {
+            std::cout << "   Temp. 5 min: media " << senalTemp->ventana.promedio()
+                      << " / min " << senalTemp->ventana.minimo()
+                      << " / max " << senalTemp->ventana.maximo()
+                      << " / tendencia " << senalTemp->ventana.tasaCambio() * 60.0 << " °C/min\n";
+        }
 
         // 3. Verificar alarmas
         std::cout << "\n[3/5]  Verificando alarmas...\n";
@@ -207,43 +272,59 @@ public:
         if (modoAutomatico) {
             std::cout << "\n[4/5]  Ejecutando control automático [" << modoControl << "]...\n";
             
-            // Preparar mapa de sensores
-            std::map<std::string, double> sensores;
-            sensores["TEMP"] = tempAmb;
-            sensores["HUM_SUELO"] = humSuelo;
-            sensores["HUM_REL"] = humRel;
-            sensores["LUZ"] = luz;
-            sensores["PH"] = ph;
-            sensores["CO2"] = co2;
-            sensores["AGUA"] = agua;
+            // Valores del ciclo en un arreglo de indice fijo (VariableControl)
+            ValoresControl sensores;
+            sensores[VAR_TEMP] = tempAmb;
+            sensores[VAR_HUM_SUELO] = humSuelo;
+            sensores[VAR_HUM_REL] = humRel;
+            sensores[VAR_LUZ] = luz;
+            sensores[VAR_PH] = ph;
+            sensores[VAR_CO2] = co2;
+            sensores[VAR_AGUA] = agua;
+            // Senales en ventana, disponibles para las condiciones de control
+            // (sin lecturas quedan en NaN y ninguna condicion sobre ellas se cumple)
+            if (senalTemp) {
+                sensores[VAR_TEMP_MEDIA] = senalTemp->ventana.promedio();
+                sensores[VAR_TEMP_EMA] = senalTemp->media.getValor();
+                sensores[VAR_TEMP_TASA] = senalTemp->ventana.tasaCambio() * 60.0;
+            }
+            if (senalHumSuelo) {
+                sensores[VAR_HUM_SUELO_MEDIA] = senalHumSuelo->ventana.promedio();
+                sensores[VAR_HUM_SUELO_TASA] = senalHumSuelo->ventana.tasaCambio() * 60.0;
+            }
+            if (senalHumRel) {
+                sensores[VAR_HUM_REL_MEDIA] = senalHumRel->ventana.promedio();
+            }
 
             if (modoControl == "ARBOL") {
                 // Control basado en árbol de decisión
                 std::cout << "\n   ÁRBOL DE DECISIÓN:\n";
-                auto acciones = arbolControl->decidir(sensores);
-                arbolControl->mostrarProcesoDecision();
+                std::shared_ptr<ArbolDecision> arbol = std::atomic_load(&arbolControl);
+                RangoAcciones acciones = arbol->decidir(sensores);
+                arbol->mostrarProcesoDecision();
                 
                 // Aplicar acciones
                 for (const auto& accion : acciones) {
-                    aplicarAccion(accion.actuador, accion.intensidad);
+                    aplicarAccion(accion.idActuador, accion.intensidad);
                 }
             } else if (modoControl == "GRAFO") {
                 // Control basado en grafo de estados
                 std::cout << "\n   GRAFO DE ESTADOS:\n";
-                std::string estadoAnterior = grafoEstados->getEstadoActual();
-                std::string nuevoEstado = grafoEstados->evaluarTransiciones(sensores);
+                std::shared_ptr<GrafoEstados> grafo = std::atomic_load(&grafoEstados);
+                int estadoAnterior = grafo->getIdEstadoActual();
+                int nuevoEstado = grafo->evaluarTransiciones(sensores, ahoraMs);
                 
                 if (estadoAnterior != nuevoEstado) {
-                    std::cout << "   Transición: " << estadoAnterior 
-                             << "  " << nuevoEstado << "\n";
+                    std::cout << "   Transición: " << grafo->getNombreEstado(estadoAnterior)
+                             << "  " << grafo->getNombreEstado(nuevoEstado) << "\n";
                 }
                 
-                grafoEstados->mostrarEstadoActual();
+                grafo->mostrarEstadoActual();
                 
-                // Aplicar configuración del estado
-                auto config = grafoEstados->getConfiguracionActual();
-                for (const auto& par : config) {
-                    aplicarAccion(par.first, par.second);
+                // Aplicar configuración del estado (arreglo fijo por IdActuador)
+                const ConfiguracionActuadores& config = grafo->getConfiguracionActual();
+                for (int i = 0; i < NUM_ACTUADORES; i++) {
+                    aplicarAccion((IdActuador)i, config[i]);
                 }
             }
         } else {
@@ -273,19 +354,35 @@ public:
     }
 
     // Aplicar acción de control a actuador
-    void aplicarAccion(std::string actuador, double intensidad) {
-        if (actuador == "VENTILADOR") {
-            ventilador->ajustar(intensidad);
-        } else if (actuador == "CALEFACTOR") {
-            calefactor->ajustar(intensidad);
-        } else if (actuador == "RIEGO") {
-            riego->ajustar(intensidad);
-        } else if (actuador == "LUZ_LED") {
-            luzLED->ajustar(intensidad);
-        } else if (actuador == "NEBULIZADOR") {
-            if (intensidad > 0) nebulizador->ajustar(intensidad);
-            else nebulizador->desactivar();
+    void aplicarAccion(IdActuador actuador, double intensidad) {
+        switch (actuador) {
+            case ACT_VENTILADOR: ventilador->ajustar(intensidad); break;
+            case ACT_CALEFACTOR: calefactor->ajustar(intensidad); break;
+            case ACT_RIEGO: riego->ajustar(intensidad); break;
+            case ACT_LUZ_LED: luzLED->ajustar(intensidad); break;
+            case ACT_NEBULIZADOR:
+                if (intensidad > 0) nebulizador->ajustar(intensidad);
+                else nebulizador->desactivar();
+                break;
+            default: break;
+        }
+    }
+
+    // Registrar alarma activa: una sola entrada por (sensor, tipo)
+    // Si la condicion persiste se actualiza la alarma existente (valor, mensaje
+    // y prioridad, que solo puede escalar) en vez de apilar una copia por ciclo.
+    void registrarAlarma(Alarma alarma) {
+        ClaveAlarma clave(alarma.sensorID, alarma.tipo);
+        bool existente = colaAlarmas->modificar(clave, [&alarma](Alarma& activa) {
+            activa.valor = alarma.valor;
+            activa.mensaje.swap(alarma.mensaje);
+            activa.prioridad = std::min(activa.prioridad, alarma.prioridad);
+        });
+        if (!existente) {
+            logAlarmas->insertarFinal(alarma);
+            colaAlarmas->insertarOActualizar(clave, std::move(alarma));
         }
+        controlActuadores->registrarAlarma(!modoAutomatico);
     }
 
     // Verificar condiciones y generar alarmas
@@ -296,36 +393,28 @@ public:
             Alarma alarma(1, "CRITICA", 
                 "Temperatura critica: " + std::to_string((int)temp) + "C", 
                 "TEMP", temp);
-            colaAlarmas->insertar(alarma);
-            logAlarmas->insertarFinal(alarma);
-            controlActuadores->registrarAlarma(!modoAutomatico);
+            registrarAlarma(std::move(alarma));
         }
 
         if (humSuelo < (30.0 / multiplicadorManual)) {
             Alarma alarma(2, "ALTA", 
                 "Humedad del suelo critica: " + std::to_string((int)humSuelo) + "%",
                 "HUM_SUELO", humSuelo);
-            colaAlarmas->insertar(alarma);
-            logAlarmas->insertarFinal(alarma);
-            controlActuadores->registrarAlarma(!modoAutomatico);
+            registrarAlarma(std::move(alarma));
         }
 
         if (agua < 50.0) {
             Alarma alarma(1, "CRITICA",
                 "Nivel de agua critico: " + std::to_string((int)agua) + "L",
                 "AGUA", agua);
-            colaAlarmas->insertar(alarma);
-            logAlarmas->insertarFinal(alarma);
-            controlActuadores->registrarAlarma(!modoAutomatico);
+            registrarAlarma(std::move(alarma));
         }
         
         if (!modoAutomatico && (humRel < 40 || humRel > 90)) {
             Alarma alarma(3, "MEDIA", 
                 "Humedad relativa fuera de rango: " + std::to_string((int)humRel) + "%",
                 "HUM_REL", humRel);
-            colaAlarmas->insertar(alarma);
-            logAlarmas->insertarFinal(alarma);
-            controlActuadores->registrarAlarma(true);
+            registrarAlarma(std::move(alarma));
         }
     }
 
@@ -357,36 +446,97 @@ public:
         std::cout << "¦ Modo: " << ( modoAutomatico ? "AUTOMATICO" : "MANUAL") << "\n";
         std::cout << "¦ Sistema: " << modoControl << "\n";
         if (modoControl == "GRAFO") {
-            std::cout << "¦ Estado: " << grafoEstados->getEstadoActual() << "\n";
+            std::cout << "¦ Estado: " << std::atomic_load(&grafoEstados)->getEstadoActual() << "\n";
         }
         std::cout << "+---------------------------------------------------+\n";
 
         std::cout << "\n+--- ALARMAS ACTIVAS (" << colaAlarmas->getTamano() << ") ---------------------------+\n";
         if (!colaAlarmas->estaVacio()) {
-            HeapPrioridad<Alarma> tempHeap = *colaAlarmas;
-            int mostradas = 0;
-            while (!tempHeap.estaVacio() && mostradas < 3) {
-                Alarma a = tempHeap.extraerMin();
-                std::cout << "¦ [" << a.getNivelPrioridad() << "] " 
-                          << a.mensaje.substr(0, 40) << "\n";
-                mostradas++;
+            // Vista de las 3 mas urgentes sin copiar el heap
+            for (const Alarma* a : colaAlarmas->verPrimeros(3)) {
+                std::cout << "¦ [" << a->getNivelPrioridad() << "] " 
+                          << a->mensaje.substr(0, 40) << "\n";
             }
         } else {
             std::cout << "¦ No hay alarmas activas                            ¦\n";
         }
         std::cout << "+---------------------------------------------------+\n";
 
+        long criticas = std::count_if(logAlarmas->begin(), logAlarmas->end(),
+                                      [](const Alarma& a) { return a.prioridad == 1; });
         std::cout << "\nCiclo: " << ciclosSimulacion 
-                  << " | Lecturas: " << historialLecturas->getTamano() << "\n";
+                  << " | Lecturas: " << historialLecturas->getTamano()
+                  << " | Alarmas registradas: " << logAlarmas->getTamano()
+                  << " (" << criticas << " criticas)\n";
     }
 
     // Métodos para visualizar sistemas de control
     void mostrarArbolDecision() {
-        arbolControl->mostrarArbol();
+        std::atomic_load(&arbolControl)->mostrarArbol();
     }
 
     void mostrarGrafoEstados() {
-        grafoEstados->mostrarGrafo();
+        std::shared_ptr<GrafoEstados> grafo = std::atomic_load(&grafoEstados);
+        grafo->mostrarGrafo();
+        grafo->mostrarPermanencias();
+    }
+
+    // Recargar el árbol desde un archivo sin detener el ciclo de control
+    // Si el archivo no es válido se informa el error y sigue el árbol actual.
+    bool recargarArbol(const std::string& ruta) {
+        try {
+            std::shared_ptr<ArbolDecision> nuevo = ConfiguracionControl::cargarArbolArchivo(ruta);
+            nuevo->setTrazado(true);
+            std::atomic_store(&arbolControl, nuevo);
+            pilaConfiguraciones->push("Arbol recargado: " + ruta);
+            std::cout << "\n Árbol cargado: " << nuevo->getCantidadNodos() << " nodos, profundidad "
+                      << nuevo->getProfundidad() << "\n";
+            return true;
+        } catch (const std::exception& e) {
+            std::cout << "\n Error al cargar el árbol: " << e.what() << "\n";
+            return false;
+        }
+    }
+
+    // Hilo de control: publicar el grafo recargado, si hay uno, conservando
+    // el estado actual cuando existe en el nuevo - O(log E)
+    void adoptarGrafoPendiente() {
+        std::shared_ptr<GrafoEstados> nuevo = std::atomic_exchange(&grafoPendiente, std::shared_ptr<GrafoEstados>());
+        if (!nuevo) return;
+        const std::string& actual = std::atomic_load(&grafoEstados)->getEstadoActual();
+        if (nuevo->existeEstado(actual)) nuevo->setEstadoActual(actual);
+        std::atomic_store(&grafoEstados, nuevo);
+        std::cout << "\n   Grafo recargado en uso, estado actual " << nuevo->getEstadoActual() << "\n";
+    }
+
+    // Recargar el grafo: se valida aqui y el ciclo de control lo adopta al
+    // comenzar el siguiente ciclo (una recarga posterior reemplaza a la pendiente)
+    bool recargarGrafo(const std::string& ruta) {
+        try {
+            std::shared_ptr<GrafoEstados> nuevo = ConfiguracionControl::cargarGrafoArchivo(ruta);
+            std::atomic_store(&grafoPendiente, nuevo);
+            pilaConfiguraciones->push("Grafo recargado: " + ruta);
+            std::cout << "\n Grafo cargado: " << nuevo->getCantidadEstados()
+                      << " estados; se aplica al comenzar el proximo ciclo\n";
+            return true;
+        } catch (const std::exception& e) {
+            std::cout << "\n Error al cargar el grafo: " << e.what() << "\n";
+            return false;
+        }
+    }
+
+    // Escribir la configuración activa como plantilla editable
+    bool exportarControl(const std::string& rutaArbol, const std::string& rutaGrafo) {
+        std::ofstream archivoArbol(rutaArbol);
+        std::ofstream archivoGrafo(rutaGrafo);
+        if (!archivoArbol.is_open() || !archivoGrafo.is_open()) {
+            std::cout << "\n No se pudieron crear los archivos de configuración\n";
+            return false;
+        }
+        std::atomic_load(&arbolControl)->escribir(archivoArbol);
+        std::atomic_load(&grafoEstados)->escribir(archivoGrafo);
+        std::cout << "\n Configuración exportada a " << rutaArbol << " y " << rutaGrafo << "\n";
+        return true;
     }
 
     // Cambiar modo de control
@@ -405,7 +555,13 @@ public:
     bool getModoAutomatico() const { return modoAutomatico; }
     int getCiclosSimulacion() const { return ciclosSimulacion; }
     int getTamanoHistorial() const { return historialLecturas->getTamano(); }
-    int getAlturaAVL() const { return indiceTimestamp->getAltura(); }
+    int getAlturaAVL() const { return indiceLecturas->getAltura(); }
+
+    // Cantidad, promedio y extremos de temperatura en [desde, hasta] - O(log n)
+    ResumenRango resumenTemperatura(time_t desde, time_t hasta) const {
+        return indiceLecturas->resumenRangoSensor(sensorTempAmb->getIdInterno(), (long long)desde * 1000,
+                                                  (long long)hasta * 1000 + 999);
+    }
     int getNumAlarmas() const { return colaAlarmas->getTamano(); }
 
     void procesarAlarma() {
@@ -416,6 +572,99 @@ public:
         }
     }
 
+    // Productor (hilo de interfaz): publicar comando para el ciclo de control
+    // Si la cola esta llena espera a que el ciclo la drene (contrapresion)
+    bool enviarComando(IdActuador actuador, double intensidad) {
+        return colaComandos->encolar(ComandoActuador(actuador, intensidad));
+    }
+
+    // Usar otro reloj (p. ej. RelojSimulado) para lecturas y ciclo dia/noche
+    // El reloj debe vivir mas que el invernadero
+    void setReloj(const Reloj* _reloj) {
+        reloj = _reloj;
+        for (Sensor* sensor : sensores) sensor->setReloj(_reloj);
+    }
+
+    // Fijar la semilla del ruido de todos los sensores (corridas reproducibles)
+    void sembrarSensores(uint64_t semilla) {
+        for (Sensor* sensor : sensores) sensor->sembrar(semilla);
+    }
+
+    // Productores (hilos lectores): publicar un lote de lecturas sin bloquear
+    // Las lecturas publicadas se mueven fuera del lote; retorna cuantas entraron
+    int publicarLecturas(Lectura* lote, int cantidad) {
+        return colaIngesta->intentarEncolarLote(lote, cantidad);
+    }
+
+    // Consumidor (hilo de control): pasar las lecturas pendientes al historial
+    // y al indice por lotes. La secuencia (8 bits) desempata lecturas del mismo
+    // sensor y milisegundo: se reinicia cuando cambia el milisegundo del sensor.
+    // Una lectura cuya clave ya existe (mas de 256 en el mismo ms, o un ms que
+    // vuelve atras) no entra en ningun lado y se cuenta en lecturasRechazadas,
+    // asi historial e indice siempre tienen las mismas lecturas.
+    int drenarIngesta() {
+        Lectura lote[TAMANO_LOTE_INGESTA];
+        int total = 0;
+        int cantidad;
+        while ((cantidad = colaIngesta->intentarDesencolarLote(lote, TAMANO_LOTE_INGESTA)) > 0) {
+            for (int i = 0; i < cantidad; i++) {
+                if (lote[i].sensor >= secuencias.size()) {
+                    SecuenciaSensor vacia = {LLONG_MIN, 0};
+                    secuencias.resize(lote[i].sensor + 1, vacia);
+                }
+                SecuenciaSensor& sec = secuencias[lote[i].sensor];
+                if (lote[i].tiempoMs != sec.tiempoMs) {
+                    sec.tiempoMs = lote[i].tiempoMs;
+                    sec.siguiente = 0;
+                }
+                if (sec.siguiente > UINT8_MAX) {
+                    lecturasRechazadas++;
+                    continue;
+                }
+                lote[i].secuencia = (uint8_t)sec.siguiente++;
+                if (!indiceLecturas->insertar(lote[i])) {
+                    lecturasRechazadas++;
+                    continue;
+                }
+
+                if (lote[i].sensor >= estadisticasFlujo.size()) {
+                    estadisticasFlujo.resize(lote[i].sensor + 1);
+                }
+                estadisticasFlujo[lote[i].sensor].agregar(lote[i].valor);
+                if (lote[i].sensor >= senales.size()) {
+                    senales.resize(lote[i].sensor + 1);
+                }
+                senales[lote[i].sensor].agregar(lote[i].tiempoMs, lote[i].valor);
+                historialLecturas->insertarFinal(std::move(lote[i]));
+            }
+            total += cantidad;
+        }
+
+        // Retencion: el indice cubre la misma ventana de tiempo que el historial
+        if (total > 0 && !historialLecturas->estaVacia()) {
+            indiceLecturas->eliminarAnteriores(historialLecturas->primero().tiempoMs);
+        }
+        return total;
+    }
+
+    // Consumidor (hilo de control): aplicar todos los comandos pendientes
+    int procesarComandos() {
+        int aplicados = 0;
+        ComandoActuador comando;
+        while (colaComandos->intentarDesencolar(comando)) {
+            switch (comando.actuador) {
+                case ACT_VENTILADOR: ajustarVentilador(comando.intensidad); break;
+                case ACT_CALEFACTOR: ajustarCalefactor(comando.intensidad); break;
+                case ACT_RIEGO: ajustarRiego(comando.intensidad); break;
+                case ACT_LUZ_LED: ajustarLuzLED(comando.intensidad); break;
+                case ACT_NEBULIZADOR: ajustarNebulizador(comando.intensidad); break;
+                default: continue;
+            }
+            aplicados++;
+        }
+        return aplicados;
+    }
+
     // Control manual simplificado
     void ajustarVentilador(double intensidad) {
         ventilador->ajustar(intensidad);
@@ -458,6 +707,25 @@ public:
         std::cout << "  Nivel actual: " << sensorAgua->getValorActual() << " L\n";
     }
 
+    // Estadisticas acumuladas de un sensor desde el inicio - O(1)
+    AcumuladorEstadistico getAcumulador(uint16_t sensor) const {
+        return sensor < estadisticasFlujo.size() ? estadisticasFlujo[sensor].momentos : AcumuladorEstadistico();
+    }
+
+    // Senales en ventana de un sensor; nullptr si aun no tiene lecturas - O(1)
+    // (el vector crece hasta el id mayor, asi que puede haber huecos vacios)
+    const SenalesVentana* getSenales(uint16_t sensor) const {
+        if (sensor >= senales.size() || senales[sensor].ventana.estaVacia()) return nullptr;
+        return &senales[sensor];
+    }
+
+    long getLecturasRechazadas() const { return lecturasRechazadas; }
+
+    // Cuantil q en [0, 1] de todas las lecturas de un sensor, estimado - O(k log k)
+    double getCuantil(uint16_t sensor, double q) const {
+        return sensor < estadisticasFlujo.size() ? estadisticasFlujo[sensor].cuantiles.cuantil(q) : 0.0;
+    }
+
     // Análisis estadístico simplificado
     void mostrarEstadisticas() {
         if (historialLecturas->getTamano() < 10) {
@@ -465,25 +733,19 @@ public:
             return;
         }
 
-        std::vector<double> datosTemp;
-        std::vector<Lectura> lecturas = historialLecturas->obtenerTodos();
-        for (const Lectura& lec : lecturas) {
-            if (lec.sensorID == "TEMP") {
-                datosTemp.push_back(lec.valor);
-            }
-        }
-
-        if (datosTemp.empty()) return;
+        // Agregados del indice por sensor: no se recorre el historial
+        ResumenRango temp = indiceLecturas->resumenSensor(sensorTempAmb->getIdInterno());
+        if (temp.cantidad == 0) return;
 
         std::cout << "\n+----------------------------------------------------+\n";
         std::cout << "¦        ANÁLISIS ESTADÍSTICO - TEMPERATURA         ¦\n";
         std::cout << "+----------------------------------------------------+\n";
         std::cout << std::fixed << std::setprecision(2);
-        std::cout << "\nMuestras: " << datosTemp.size() << "\n";
-        std::cout << "Promedio: " << Estadisticas::calcularPromedio(datosTemp) << " °C\n";
-        std::cout << "Desviación: " << Estadisticas::calcularDesviacion(datosTemp) << " °C\n";
-        std::cout << "Mínimo: " << Estadisticas::encontrarMinimo(datosTemp) << " °C\n";
-        std::cout << "Máximo: " << Estadisticas::encontrarMaximo(datosTemp) << " °C\n";
+        std::cout << "\nMuestras: " << temp.cantidad << "\n";
+        std::cout << "Promedio: " << temp.promedio() << " °C\n";
+        std::cout << "Desviación: " << temp.desviacion() << " °C\n";
+        std::cout << "Mínimo: " << temp.minimo << " °C\n";
+        std::cout << "Máximo: " << temp.maximo << " °C\n";
     }
 
     // Mostrar estadísticas avanzadas
@@ -493,14 +755,12 @@ public:
             return;
         }
 
-        std::vector<double> datosTemp, datosHumSuelo, datosHumRel;
-        std::vector<Lectura> lecturas = historialLecturas->obtenerTodos();
-        
-        for (const Lectura& lec : lecturas) {
-            if (lec.sensorID == "TEMP") datosTemp.push_back(lec.valor);
-            else if (lec.sensorID == "HUM_SUELO") datosHumSuelo.push_back(lec.valor);
-            else if (lec.sensorID == "HUM_REL") datosHumRel.push_back(lec.valor);
-        }
+        // Momentos, extremos y cuantiles salen de las estadisticas en flujo:
+        // cubren todo el historico sin recorrer ni ordenar lecturas
+        uint16_t idTemp = sensorTempAmb->getIdInterno();
+        uint16_t idHumSuelo = sensorHumSuelo->getIdInterno();
+        AcumuladorEstadistico temp = getAcumulador(idTemp);
+        AcumuladorEstadistico humSuelo = getAcumulador(idHumSuelo);
 
         std::cout << "\n+====================================================+\n";
         std::cout << "|         ESTADISTICAS AVANZADAS DEL SISTEMA         |\n";
@@ -508,17 +768,21 @@ public:
 
         std::cout << "+---- TEMPERATURA ------------------------------+\n";
         std::cout << "  Promedio:     " << std::fixed << std::setprecision(1)
-                  << Estadisticas::calcularPromedio(datosTemp) << " °C\n";
-        std::cout << "  Desv. Estándar: " << Estadisticas::calcularDesviacion(datosTemp) << " °C\n";
-        std::cout << "  Rango:        " << Estadisticas::calcularRango(datosTemp) << " °C\n";
-        std::cout << "  Mediana:      " << Estadisticas::calcularMediana(datosTemp) << " °C\n";
+                  << temp.promedio() << " °C\n";
+        std::cout << "  Desv. Estándar: " << temp.desviacion() << " °C\n";
+        std::cout << "  Rango:        " << temp.rango() << " °C\n";
+        std::cout << "  Mediana:      " << getCuantil(idTemp, 0.50) << " °C\n";
+        std::cout << "  P95 / P99:    " << getCuantil(idTemp, 0.95) << " / "
+                  << getCuantil(idTemp, 0.99) << " °C\n";
         std::cout << "+-------------------------------------------+\n";
 
         std::cout << "\n+---- HUMEDAD SUELO ----------------------------+\n";
-        std::cout << "  Promedio:     " << Estadisticas::calcularPromedio(datosHumSuelo) << " %\n";
-        std::cout << "  Desv. Estándar: " << Estadisticas::calcularDesviacion(datosHumSuelo) << " %\n";
-        std::cout << "  Rango:        " << Estadisticas::calcularRango(datosHumSuelo) << " %\n";
-        std::cout << "  Mediana:      " << Estadisticas::calcularMediana(datosHumSuelo) << " %\n";
+        std::cout << "  Promedio:     " << humSuelo.promedio() << " %\n";
+        std::cout << "  Desv. Estándar: " << humSuelo.desviacion() << " %\n";
+        std::cout << "  Rango:        " << humSuelo.rango() << " %\n";
+        std::cout << "  Mediana:      " << getCuantil(idHumSuelo, 0.50) << " %\n";
+        std::cout << "  P95 / P99:    " << getCuantil(idHumSuelo, 0.95) << " / "
+                  << getCuantil(idHumSuelo, 0.99) << " %\n";
         std::cout << "+-------------------------------------------+\n";
 
         std::cout << "\n+---- GENERAL ---------------------------------+\n";
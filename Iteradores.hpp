@@ -0,0 +1,156 @@
+#ifndef ITERADORES_HPP
+#define ITERADORES_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Iteradores compatibles con la STL para los contenedores enlazados
+// V es T para el iterador mutable y const T para el constante; el
+// iterador mutable se convierte implicitamente en el constante.
+
+// Iterador hacia adelante sobre nodos con puntero 'siguiente'
+// (ListaEnlazada, Pila, Cola). El fin es nullptr.
+template <typename N, typename V>
+class IteradorNodo {
+private:
+    N* actual;
+
+    template <typename, typename> friend class IteradorNodo;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<V>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V* pointer;
+    typedef V& reference;
+
+    explicit IteradorNodo(N* nodo = nullptr) : actual(nodo) {}
+
+    template <typename W, typename = typename std::enable_if<std::is_convertible<W*, V*>::value>::type>
+    IteradorNodo(const IteradorNodo<N, W>& otro) : actual(otro.actual) {}
+
+    reference operator*() const { return actual->dato; }
+    pointer operator->() const { return &actual->dato; }
+
+    IteradorNodo& operator++() {
+        actual = actual->siguiente;
+        return *this;
+    }
+
+    IteradorNodo operator++(int) {
+        IteradorNodo copia = *this;
+        actual = actual->siguiente;
+        return copia;
+    }
+
+    bool operator==(const IteradorNodo& otro) const { return actual == otro.actual; }
+    bool operator!=(const IteradorNodo& otro) const { return actual != otro.actual; }
+};
+
+// Iterador bidireccional sobre NodoDoble (ListaDoble). El fin es nullptr y
+// recuerda el ultimo nodo para que --end() sea valido (std::reverse_iterator).
+template <typename N, typename V>
+class IteradorNodoDoble {
+private:
+    N* actual;
+    N* ultimo;
+
+    template <typename, typename> friend class IteradorNodoDoble;
+
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename std::remove_const<V>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V* pointer;
+    typedef V& reference;
+
+    IteradorNodoDoble(N* nodo = nullptr, N* _ultimo = nullptr) : actual(nodo), ultimo(_ultimo) {}
+
+    template <typename W, typename = typename std::enable_if<std::is_convertible<W*, V*>::value>::type>
+    IteradorNodoDoble(const IteradorNodoDoble<N, W>& otro) : actual(otro.actual), ultimo(otro.ultimo) {}
+
+    reference operator*() const { return actual->dato; }
+    pointer operator->() const { return &actual->dato; }
+
+    IteradorNodoDoble& operator++() {
+        actual = actual->siguiente;
+        return *this;
+    }
+
+    IteradorNodoDoble operator++(int) {
+        IteradorNodoDoble copia = *this;
+        ++(*this);
+        return copia;
+    }
+
+    IteradorNodoDoble& operator--() {
+        actual = actual ? actual->anterior : ultimo;
+        return *this;
+    }
+
+    IteradorNodoDoble operator--(int) {
+        IteradorNodoDoble copia = *this;
+        --(*this);
+        return copia;
+    }
+
+    bool operator==(const IteradorNodoDoble& otro) const { return actual == otro.actual; }
+    bool operator!=(const IteradorNodoDoble& otro) const { return actual != otro.actual; }
+};
+
+// Iterador bidireccional sobre un anillo de NodoDoble (ListaCircular)
+// Da una sola vuelta: la posicion es el numero de pasos desde la cabeza,
+// asi que begin() y end() apuntan al mismo nodo pero son distintos.
+template <typename N, typename V>
+class IteradorCircular {
+private:
+    N* actual;
+    int pasos;
+
+    template <typename, typename> friend class IteradorCircular;
+
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename std::remove_const<V>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V* pointer;
+    typedef V& reference;
+
+    IteradorCircular(N* nodo = nullptr, int _pasos = 0) : actual(nodo), pasos(_pasos) {}
+
+    template <typename W, typename = typename std::enable_if<std::is_convertible<W*, V*>::value>::type>
+    IteradorCircular(const IteradorCircular<N, W>& otro) : actual(otro.actual), pasos(otro.pasos) {}
+
+    reference operator*() const { return actual->dato; }
+    pointer operator->() const { return &actual->dato; }
+
+    IteradorCircular& operator++() {
+        actual = actual->siguiente;
+        pasos++;
+        return *this;
+    }
+
+    IteradorCircular operator++(int) {
+        IteradorCircular copia = *this;
+        ++(*this);
+        return copia;
+    }
+
+    IteradorCircular& operator--() {
+        actual = actual->anterior;
+        pasos--;
+        return *this;
+    }
+
+    IteradorCircular operator--(int) {
+        IteradorCircular copia = *this;
+        --(*this);
+        return copia;
+    }
+
+    bool operator==(const IteradorCircular& otro) const { return pasos == otro.pasos; }
+    bool operator!=(const IteradorCircular& otro) const { return pasos != otro.pasos; }
+};
+
+#endif
@@ -1,33 +1,70 @@
 #ifndef LECTURA_HPP
 #define LECTURA_HPP
 
-#include <string>
+#include "RegistroSensores.hpp"
+#include <cstdint>
 #include <ctime>
+#include <string>
+#include <type_traits>
+
+// Estado de una lectura segun los umbrales del sensor
+enum EstadoLectura : uint8_t {
+    ESTADO_NORMAL,
+    ESTADO_ALERTA,
+    ESTADO_CRITICO
+};
+
+inline const char* nombreEstado(EstadoLectura estado) {
+    switch (estado) {
+        case ESTADO_ALERTA: return "alerta";
+        case ESTADO_CRITICO: return "critico";
+        default: return "normal";
+    }
+}
 
 // Clase para almacenar una lectura de sensor
+// Registro compacto de 16 bytes sin memoria dinamica: el sensor es un id
+// internado en RegistroSensores y el estado un enum; los textos solo se
+// obtienen al mostrar. Orden total por clave compuesta (tiempoMs, sensor,
+// secuencia): dos lecturas del mismo milisegundo no colapsan.
 class Lectura {
 public:
-    time_t timestamp;
-    std::string sensorID;
-    double valor;
-    std::string estado; // "normal", "alerta", "critico"
+    int64_t tiempoMs;       // marca de tiempo con resolucion de milisegundos
+    float valor;
+    uint16_t sensor;        // id internado (RegistroSensores)
+    EstadoLectura estado;
+    uint8_t secuencia;      // desempate para lecturas del mismo sensor y milisegundo
+
+    Lectura() : tiempoMs(0), valor(0.0f), sensor(RegistroSensores::SIN_SENSOR),
+                estado(ESTADO_NORMAL), secuencia(0) {}
 
-    Lectura() : timestamp(0), sensorID(""), valor(0.0), estado("normal") {}
+    Lectura(int64_t ms, uint8_t sec, uint16_t _sensor, double v, EstadoLectura est = ESTADO_NORMAL)
+        : tiempoMs(ms), valor((float)v), sensor(_sensor), estado(est), secuencia(sec) {}
 
-    Lectura(time_t t, std::string id, double v, std::string est = "normal") 
-        : timestamp(t), sensorID(id), valor(v), estado(est) {}
+    time_t getTimestamp() const { return (time_t)(tiempoMs / 1000); }
+
+    // Vistas de texto para mostrar
+    const std::string& getSensorID() const { return RegistroSensores::nombre(sensor); }
+    const char* getEstado() const { return nombreEstado(estado); }
 
     bool operator<(const Lectura& otra) const {
-        return timestamp < otra.timestamp;
+        if (tiempoMs != otra.tiempoMs) return tiempoMs < otra.tiempoMs;
+        if (sensor != otra.sensor) return sensor < otra.sensor;
+        return secuencia < otra.secuencia;
     }
 
     bool operator>(const Lectura& otra) const {
-        return timestamp > otra.timestamp;
+        return otra < *this;
     }
 
     bool operator==(const Lectura& otra) const {
-        return timestamp == otra.timestamp && sensorID == otra.sensorID;
+        return tiempoMs == otra.tiempoMs && sensor == otra.sensor &&
+               secuencia == otra.secuencia;
     }
 };
 
+// Se copia con memcpy y puede escribirse tal cual en disco
+static_assert(sizeof(Lectura) == 16, "Lectura debe ocupar 16 bytes");
+static_assert(std::is_trivially_copyable<Lectura>::value, "Lectura debe ser trivialmente copiable");
+
 #endif
@@ -2,22 +2,22 @@
 #define LISTA_CIRCULAR_HPP
 
 #include "Nodo.hpp"
+#include "AsignadorNodos.hpp"
+#include "Iteradores.hpp"
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-template <typename T>
+template <typename T, template <typename> class Asignador = AsignadorNew>
 class ListaCircular {
 private:
     NodoDoble<T>* cabeza;
     int tamano;
+    Asignador<NodoDoble<T>> asignador;
 
-public:
-    ListaCircular() : cabeza(nullptr), tamano(0) {}
-    ~ListaCircular() { limpiar(); }
-
-    // Insertar al final - O(1)
-    void insertar(T dato) {
-        NodoDoble<T>* nuevo = new NodoDoble<T>(dato);
+    // Enlazar antes de la cabeza (al final del anillo) - O(1)
+    void enlazar(NodoDoble<T>* nuevo) {
         if (estaVacia()) {
             cabeza = nuevo;
             cabeza->siguiente = cabeza;
@@ -31,20 +31,38 @@ public:
         tamano++;
     }
 
+public:
+    typedef IteradorCircular<NodoDoble<T>, T> iterator;
+    typedef IteradorCircular<NodoDoble<T>, const T> const_iterator;
+
+    ListaCircular() : cabeza(nullptr), tamano(0) {}
+    ~ListaCircular() { limpiar(); }
+
+    // Insertar al final - O(1)
+    void insertar(const T& dato) { enlazar(asignador.crear(dato)); }
+    void insertar(T&& dato) { enlazar(asignador.crear(std::move(dato))); }
+
+    // Construir el elemento directamente en un nodo al final - O(1)
+    template <typename... Args>
+    T& emplazar(Args&&... args) {
+        enlazar(asignador.crear(std::forward<Args>(args)...));
+        return cabeza->anterior->dato;
+    }
+
     // Eliminar elemento - O(n) (busca y elimina)
-    void eliminar(T dato) {
+    void eliminar(const T& dato) {
         if (estaVacia()) return;
         NodoDoble<T>* actual = cabeza;
         do {
             if (actual->dato == dato) {
                 if (tamano == 1) {
-                    delete cabeza;
+                    asignador.destruir(cabeza);
                     cabeza = nullptr;
                 } else {
                     actual->anterior->siguiente = actual->siguiente;
                     actual->siguiente->anterior = actual->anterior;
                     if (actual == cabeza) cabeza = actual->siguiente;
-                    delete actual;
+                    asignador.destruir(actual);
                 }
                 tamano--;
                 return;
@@ -54,7 +72,7 @@ public:
     }
 
     // Buscar - O(n)
-    bool buscar(T dato) const {
+    bool buscar(const T& dato) const {
         if (estaVacia()) return false;
         NodoDoble<T>* actual = cabeza;
         do {
@@ -69,16 +87,33 @@ public:
 
     void limpiar() {
         if (estaVacia()) return;
-        NodoDoble<T>* actual = cabeza;
-        do {
-            NodoDoble<T>* temp = actual;
-            actual = actual->siguiente;
-            delete temp;
-        } while (actual != cabeza);
+        if (Asignador<NodoDoble<T>>::liberacionMasiva && std::is_trivially_destructible<T>::value) {
+            asignador.reiniciar();
+        } else {
+            NodoDoble<T>* actual = cabeza;
+            do {
+                NodoDoble<T>* temp = actual;
+                actual = actual->siguiente;
+                asignador.destruir(temp);
+            } while (actual != cabeza);
+            asignador.reiniciar();
+        }
         cabeza = nullptr;
         tamano = 0;
     }
 
+    const EstadisticasAsignador& getEstadisticasMemoria() const {
+        return asignador.getEstadisticas();
+    }
+
+    // Iteradores: una vuelta completa empezando por la cabeza
+    iterator begin() { return iterator(cabeza, 0); }
+    iterator end() { return iterator(cabeza, tamano); }
+    const_iterator begin() const { return const_iterator(cabeza, 0); }
+    const_iterator end() const { return const_iterator(cabeza, tamano); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
     // Obtener todos como vector
     std::vector<T> obtenerTodos() const {
         std::vector<T> resultado;
@@ -2,26 +2,23 @@
 #define LISTA_DOBLE_HPP
 
 #include "Nodo.hpp"
+#include "AsignadorNodos.hpp"
+#include "Iteradores.hpp"
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-template <typename T>
+template <typename T, template <typename> class Asignador = AsignadorNew>
 class ListaDoble {
 private:
     NodoDoble<T>* cabeza;
     NodoDoble<T>* cola;
     int tamano;
+    Asignador<NodoDoble<T>> asignador;
 
-public:
-    ListaDoble() : cabeza(nullptr), cola(nullptr), tamano(0) {}
-
-    ~ListaDoble() {
-        limpiar();
-    }
-
-    // Insertar al inicio - O(1)
-    void insertarInicio(T dato) {
-        NodoDoble<T>* nuevo = new NodoDoble<T>(dato);
+    void enlazarInicio(NodoDoble<T>* nuevo) {
         if (estaVacia()) {
             cabeza = cola = nuevo;
         } else {
@@ -32,9 +29,7 @@ public:
         tamano++;
     }
 
-    // Insertar al final - O(1)
-    void insertarFinal(T dato) {
-        NodoDoble<T>* nuevo = new NodoDoble<T>(dato);
+    void enlazarFinal(NodoDoble<T>* nuevo) {
         if (estaVacia()) {
             cabeza = cola = nuevo;
         } else {
@@ -45,20 +40,80 @@ public:
         tamano++;
     }
 
+    // Optimizaci�n: recorrer desde el extremo m�s cercano - O(n/2)
+    NodoDoble<T>* nodoEn(int indice) const {
+        if (indice < 0 || indice >= tamano) {
+            throw std::out_of_range("�ndice fuera de rango");
+        }
+        NodoDoble<T>* actual;
+        if (indice < tamano / 2) {
+            actual = cabeza;
+            for (int i = 0; i < indice; i++) {
+                actual = actual->siguiente;
+            }
+        } else {
+            actual = cola;
+            for (int i = tamano - 1; i > indice; i--) {
+                actual = actual->anterior;
+            }
+        }
+        return actual;
+    }
+
+    NodoDoble<T>* extremo(NodoDoble<T>* nodo) const {
+        if (nodo == nullptr) {
+            throw std::runtime_error("Lista vac�a");
+        }
+        return nodo;
+    }
+
+public:
+    typedef IteradorNodoDoble<NodoDoble<T>, T> iterator;
+    typedef IteradorNodoDoble<NodoDoble<T>, const T> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    ListaDoble() : cabeza(nullptr), cola(nullptr), tamano(0) {}
+
+    ~ListaDoble() {
+        limpiar();
+    }
+
+    // Insertar al inicio - O(1)
+    void insertarInicio(const T& dato) { enlazarInicio(asignador.crear(dato)); }
+    void insertarInicio(T&& dato) { enlazarInicio(asignador.crear(std::move(dato))); }
+
+    // Construir el elemento directamente en un nodo al inicio - O(1)
+    template <typename... Args>
+    T& emplazarInicio(Args&&... args) {
+        enlazarInicio(asignador.crear(std::forward<Args>(args)...));
+        return cabeza->dato;
+    }
+
+    // Insertar al final - O(1)
+    void insertarFinal(const T& dato) { enlazarFinal(asignador.crear(dato)); }
+    void insertarFinal(T&& dato) { enlazarFinal(asignador.crear(std::move(dato))); }
+
+    template <typename... Args>
+    T& emplazarFinal(Args&&... args) {
+        enlazarFinal(asignador.crear(std::forward<Args>(args)...));
+        return cola->dato;
+    }
+
     // Eliminar primer elemento - O(1)
     T eliminarInicio() {
         if (estaVacia()) {
             throw std::runtime_error("Lista vac�a");
         }
         NodoDoble<T>* temp = cabeza;
-        T dato = cabeza->dato;
+        T dato = std::move(cabeza->dato);
         cabeza = cabeza->siguiente;
         if (cabeza != nullptr) {
             cabeza->anterior = nullptr;
         } else {
             cola = nullptr;
         }
-        delete temp;
+        asignador.destruir(temp);
         tamano--;
         return dato;
     }
@@ -69,41 +124,30 @@ public:
             throw std::runtime_error("Lista vac�a");
         }
         NodoDoble<T>* temp = cola;
-        T dato = cola->dato;
+        T dato = std::move(cola->dato);
         cola = cola->anterior;
         if (cola != nullptr) {
             cola->siguiente = nullptr;
         } else {
             cabeza = nullptr;
         }
-        delete temp;
+        asignador.destruir(temp);
         tamano--;
         return dato;
     }
 
     // Obtener elemento en posici�n i - O(n)
-    T obtener(int indice) const {
-        if (indice < 0 || indice >= tamano) {
-            throw std::out_of_range("�ndice fuera de rango");
-        }
-        NodoDoble<T>* actual;
-        // Optimizaci�n: recorrer desde el extremo m�s cercano
-        if (indice < tamano / 2) {
-            actual = cabeza;
-            for (int i = 0; i < indice; i++) {
-                actual = actual->siguiente;
-            }
-        } else {
-            actual = cola;
-            for (int i = tamano - 1; i > indice; i--) {
-                actual = actual->anterior;
-            }
-        }
-        return actual->dato;
-    }
+    T& obtener(int indice) { return nodoEn(indice)->dato; }
+    const T& obtener(int indice) const { return nodoEn(indice)->dato; }
+
+    // Acceso a los extremos sin copiar - O(1)
+    T& primero() { return extremo(cabeza)->dato; }
+    const T& primero() const { return extremo(cabeza)->dato; }
+    T& ultimo() { return extremo(cola)->dato; }
+    const T& ultimo() const { return extremo(cola)->dato; }
 
     // Buscar elemento - O(n)
-    bool buscar(T dato) const {
+    bool buscar(const T& dato) const {
         NodoDoble<T>* actual = cabeza;
         while (actual != nullptr) {
             if (actual->dato == dato) {
@@ -122,12 +166,38 @@ public:
         return tamano;
     }
 
+    // Con una arena y T trivial se libera todo de golpe sin recorrer - O(1)
     void limpiar() {
-        while (!estaVacia()) {
-            eliminarInicio();
+        if (Asignador<NodoDoble<T>>::liberacionMasiva && std::is_trivially_destructible<T>::value) {
+            asignador.reiniciar();
+        } else {
+            while (cabeza != nullptr) {
+                NodoDoble<T>* temp = cabeza;
+                cabeza = cabeza->siguiente;
+                asignador.destruir(temp);
+            }
+            asignador.reiniciar();
         }
+        cabeza = cola = nullptr;
+        tamano = 0;
+    }
+
+    const EstadisticasAsignador& getEstadisticasMemoria() const {
+        return asignador.getEstadisticas();
     }
 
+    // Iteradores bidireccionales (rbegin/rend recorren hacia atras)
+    iterator begin() { return iterator(cabeza, cola); }
+    iterator end() { return iterator(nullptr, cola); }
+    const_iterator begin() const { return const_iterator(cabeza, cola); }
+    const_iterator end() const { return const_iterator(nullptr, cola); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
     // Recorrido hacia adelante
     template <typename Func>
     void recorrerAdelante(Func funcion) {
@@ -2,25 +2,21 @@
 #define LISTA_ENLAZADA_HPP
 
 #include "Nodo.hpp"
+#include "AsignadorNodos.hpp"
+#include "Iteradores.hpp"
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-template <typename T>
+template <typename T, template <typename> class Asignador = AsignadorNew>
 class ListaEnlazada {
 private:
     Nodo<T>* cabeza;
     Nodo<T>* cola;
     int tamano;
+    Asignador<Nodo<T>> asignador;
 
-public:
-    ListaEnlazada() : cabeza(nullptr), cola(nullptr), tamano(0) {}
-
-    ~ListaEnlazada() {
-        limpiar();
-    }
-
-    // Insertar al inicio - O(1)
-    void insertarInicio(T dato) {
-        Nodo<T>* nuevo = new Nodo<T>(dato);
+    void enlazarInicio(Nodo<T>* nuevo) {
         if (estaVacia()) {
             cabeza = cola = nuevo;
         } else {
@@ -30,9 +26,7 @@ public:
         tamano++;
     }
 
-    // Insertar al final - O(1) con puntero cola
-    void insertarFinal(T dato) {
-        Nodo<T>* nuevo = new Nodo<T>(dato);
+    void enlazarFinal(Nodo<T>* nuevo) {
         if (estaVacia()) {
             cabeza = cola = nuevo;
         } else {
@@ -42,8 +36,57 @@ public:
         tamano++;
     }
 
+    Nodo<T>* nodoEn(int indice) const {
+        if (indice < 0 || indice >= tamano) {
+            throw std::out_of_range("Indice fuera de rango");
+        }
+        Nodo<T>* actual = cabeza;
+        for (int i = 0; i < indice; i++) {
+            actual = actual->siguiente;
+        }
+        return actual;
+    }
+
+    Nodo<T>* extremo(Nodo<T>* nodo) const {
+        if (nodo == nullptr) {
+            throw std::runtime_error("Lista vacia");
+        }
+        return nodo;
+    }
+
+public:
+    typedef IteradorNodo<Nodo<T>, T> iterator;
+    typedef IteradorNodo<Nodo<T>, const T> const_iterator;
+
+    ListaEnlazada() : cabeza(nullptr), cola(nullptr), tamano(0) {}
+
+    ~ListaEnlazada() {
+        limpiar();
+    }
+
+    // Insertar al inicio - O(1)
+    void insertarInicio(const T& dato) { enlazarInicio(asignador.crear(dato)); }
+    void insertarInicio(T&& dato) { enlazarInicio(asignador.crear(std::move(dato))); }
+
+    // Construir el elemento directamente en un nodo al inicio - O(1)
+    template <typename... Args>
+    T& emplazarInicio(Args&&... args) {
+        enlazarInicio(asignador.crear(std::forward<Args>(args)...));
+        return cabeza->dato;
+    }
+
+    // Insertar al final - O(1) con puntero cola
+    void insertarFinal(const T& dato) { enlazarFinal(asignador.crear(dato)); }
+    void insertarFinal(T&& dato) { enlazarFinal(asignador.crear(std::move(dato))); }
+
+    template <typename... Args>
+    T& emplazarFinal(Args&&... args) {
+        enlazarFinal(asignador.crear(std::forward<Args>(args)...));
+        return cola->dato;
+    }
+
     // Buscar elemento - O(n)
-    bool buscar(T dato) const {
+    bool buscar(const T& dato) const {
         Nodo<T>* actual = cabeza;
         while (actual != nullptr) {
             if (actual->dato == dato) {
@@ -60,27 +103,25 @@ public:
             throw std::runtime_error("Lista vacia");
         }
         Nodo<T>* temp = cabeza;
-        T dato = cabeza->dato;
+        T dato = std::move(cabeza->dato);
         cabeza = cabeza->siguiente;
         if (cabeza == nullptr) {
             cola = nullptr;
         }
-        delete temp;
+        asignador.destruir(temp);
         tamano--;
         return dato;
     }
 
     // Obtener elemento en posici�n i - O(n)
-    T obtener(int indice) const {
-        if (indice < 0 || indice >= tamano) {
-            throw std::out_of_range("Indice fuera de rango");
-        }
-        Nodo<T>* actual = cabeza;
-        for (int i = 0; i < indice; i++) {
-            actual = actual->siguiente;
-        }
-        return actual->dato;
-    }
+    T& obtener(int indice) { return nodoEn(indice)->dato; }
+    const T& obtener(int indice) const { return nodoEn(indice)->dato; }
+
+    // Acceso a los extremos sin copiar - O(1)
+    T& primero() { return extremo(cabeza)->dato; }
+    const T& primero() const { return extremo(cabeza)->dato; }
+    T& ultimo() { return extremo(cola)->dato; }
+    const T& ultimo() const { return extremo(cola)->dato; }
 
     bool estaVacia() const {
         return cabeza == nullptr;
@@ -90,20 +131,43 @@ public:
         return tamano;
     }
 
+    // Con una arena y T trivial se libera todo de golpe sin recorrer - O(1)
     void limpiar() {
-        while (!estaVacia()) {
-            eliminarInicio();
+        if (Asignador<Nodo<T>>::liberacionMasiva && std::is_trivially_destructible<T>::value) {
+            asignador.reiniciar();
+        } else {
+            while (cabeza != nullptr) {
+                Nodo<T>* temp = cabeza;
+                cabeza = cabeza->siguiente;
+                asignador.destruir(temp);
+            }
+            asignador.reiniciar();
         }
+        cabeza = cola = nullptr;
+        tamano = 0;
     }
 
+    const EstadisticasAsignador& getEstadisticasMemoria() const {
+        return asignador.getEstadisticas();
+    }
+
+    // Iteradores (del inicio al final)
+    iterator begin() { return iterator(cabeza); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(cabeza); }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
     // Recorrido para procesamiento
     template <typename Func>
     void recorrer(Func funcion) {
-        Nodo<T>* actual = cabeza;
-        while (actual != nullptr) {
-            funcion(actual->dato);
-            actual = actual->siguiente;
-        }
+        for (T& dato : *this) funcion(dato);
+    }
+
+    template <typename Func>
+    void recorrer(Func funcion) const {
+        for (const T& dato : *this) funcion(dato);
     }
 };
 
@@ -66,6 +66,7 @@ void mostrarMenuPrincipal() {
     std::cout << "  5. Visualizar Grafo de Estados\n";
     std::cout << "  6. Cambiar modo de control (Árbol/Grafo)\n";
     std::cout << "  7. Activar/Desactivar modo automático\n";
+    std::cout << " 17. Cargar/exportar configuración de control\n";
 
     std::cout << MAGENTA;
     std::cout << "\n[ 🎮 CONTROL MANUAL ]\n";
@@ -94,6 +95,32 @@ void mostrarMenuPrincipal() {
     std::cout << RESET << "\nSeleccione una opción: ";
 }
 
+// Interpretar "<actuador> <intensidad>" y publicarlo en la cola de comandos
+void enviarComandoDesdeLinea(Invernadero& inv, const std::string& linea) {
+    std::istringstream entrada(linea);
+    char actuador;
+    double intensidad;
+    if (!(entrada >> actuador >> intensidad)) {
+        std::cout << RED << "Comando no reconocido: " << linea << "\n" << RESET;
+        return;
+    }
+
+    IdActuador id;
+    switch (actuador) {
+        case 'v': id = ACT_VENTILADOR; break;
+        case 'c': id = ACT_CALEFACTOR; break;
+        case 'r': id = ACT_RIEGO; break;
+        case 'l': id = ACT_LUZ_LED; break;
+        case 'n': id = ACT_NEBULIZADOR; break;
+        default:
+            std::cout << RED << "Actuador desconocido: " << actuador << "\n" << RESET;
+            return;
+    }
+
+    inv.enviarComando(id, intensidad);
+    std::cout << BLUE << "✓ Comando enviado al ciclo de control\n" << RESET;
+}
+
 void submenuControlSensores(Invernadero& inv) {
     limpiarPantalla();
     std::cout << MAGENTA << BOLD << "\n=== CONTROL MANUAL DE SENSORES ===\n" << RESET;
@@ -221,6 +248,40 @@ void submenuAnalisis(Invernadero& inv) {
     } while (opcion != 0);
 }
 
+void submenuConfiguracionControl(Invernadero& inv) {
+    int opcion;
+    do {
+        limpiarPantalla();
+        std::cout << CYAN << BOLD << "\n=== CONFIGURACIÓN DE CONTROL ===\n" << RESET;
+        std::cout << "1. Recargar árbol de decisión desde archivo\n";
+        std::cout << "2. Recargar grafo de estados desde archivo\n";
+        std::cout << "3. Exportar configuración actual (arbol.cfg, grafo.cfg)\n";
+        std::cout << "0. Volver\n";
+        std::cout << "Opción: ";
+        std::cin >> opcion;
+
+        std::string ruta;
+        switch (opcion) {
+            case 1:
+                std::cout << "Archivo del árbol: ";
+                std::cin >> ruta;
+                inv.recargarArbol(ruta);
+                pausar();
+                break;
+            case 2:
+                std::cout << "Archivo del grafo: ";
+                std::cin >> ruta;
+                inv.recargarGrafo(ruta);
+                pausar();
+                break;
+            case 3:
+                inv.exportarControl("arbol.cfg", "grafo.cfg");
+                pausar();
+                break;
+        }
+    } while (opcion != 0);
+}
+
 void demostrarSistemaIA(Invernadero& inv) {
     limpiarPantalla();
     std::cout << YELLOW << BOLD;
@@ -321,6 +382,8 @@ int main() {
 
     Invernadero invernadero;
     GestorPartidas gestor;
+    Simulador simulador(&invernadero);
+    simulador.setMsPorCiclo(800);
 
     int opcion;
     
@@ -358,14 +421,31 @@ int main() {
                 limpiarPantalla();
                 std::cout << "¿Cuántos ciclos deseas simular? ";
                 std::cin >> ciclos;
-                
-                pausar();
-                for (int i = 0; i < ciclos; ++i) {
-                    limpiarPantalla();
-                    invernadero.ejecutarCicloControl();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(800));
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+                // El ciclo de control corre en su propio hilo; desde aquí solo
+                // se publican comandos en la cola del invernadero
+                std::cout << GRAY << "\nDurante la simulación puede escribir:\n"
+                          << "  v|c|r|l|n <0-100>  Ajustar ventilador, calefactor, riego, luz o nebulizador\n"
+                          << "  q                  Detener la simulación\n"
+                          << "(Al terminar los ciclos presione Enter)\n" << RESET;
+                simulador.iniciarEnSegundoPlano(ciclos);
+
+                std::string linea;
+                bool detenidaPorUsuario = false;
+                while (simulador.estaEjecutando() && std::getline(std::cin, linea)) {
+                    if (linea == "q") {
+                        detenidaPorUsuario = true;
+                        break;
+                    }
+                    enviarComandoDesdeLinea(invernadero, linea);
+                }
+                simulador.detener();
+                // Si termino sola, el Enter que cerro el bucle ya sirve de pausa
+                if (detenidaPorUsuario) {
+                    std::cout << GRAY << "\nPresione Enter para continuar..." << RESET;
+                    std::getline(std::cin, linea);
                 }
-                pausar();
                 break;
             }
             case 4: {
@@ -456,6 +536,9 @@ int main() {
                 pausar();
                 break;
             }
+            case 17:
+                submenuConfiguracionControl(invernadero);
+                break;
             case 0:
                 limpiarPantalla();
                 std::cout << CYAN << "\nGracias por jugar. ¡Hasta pronto!\n" << RESET;
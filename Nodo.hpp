@@ -1,6 +1,9 @@
 #ifndef NODO_HPP
 #define NODO_HPP
 
+#include <type_traits>
+#include <utility>
+
 // Nodo gen�rico para lista enlazada simple
 template <typename T>
 class Nodo {
@@ -8,7 +11,9 @@ public:
     T dato;
     Nodo<T>* siguiente;
 
-    Nodo(T valor) : dato(valor), siguiente(nullptr) {}
+    // Construye el dato en el nodo a partir de los argumentos (copia, movimiento o emplace)
+    template <typename... Args>
+    explicit Nodo(Args&&... args) : dato(std::forward<Args>(args)...), siguiente(nullptr) {}
 };
 
 // Nodo para lista doblemente enlazada
@@ -19,10 +24,30 @@ public:
     NodoDoble<T>* siguiente;
     NodoDoble<T>* anterior;
 
-    NodoDoble(T valor) : dato(valor), siguiente(nullptr), anterior(nullptr) {}
+    template <typename... Args>
+    explicit NodoDoble(Args&&... args)
+        : dato(std::forward<Args>(args)...), siguiente(nullptr), anterior(nullptr) {}
+};
+
+// Valor numerico que el AVL agrega por subarbol (suma, minimo, maximo)
+// Tipos aritmeticos aportan su propio valor; tipos con miembro 'valor'
+// (como Lectura) aportan ese campo; el resto no aporta nada (0).
+template <typename T, typename = void>
+struct ValorAgregado {
+    static double obtener(const T&) { return 0.0; }
+};
+
+template <typename T>
+struct ValorAgregado<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+    static double obtener(const T& dato) { return static_cast<double>(dato); }
+};
+
+template <typename T>
+struct ValorAgregado<T, decltype(void(std::declval<const T&>().valor))> {
+    static double obtener(const T& dato) { return static_cast<double>(dato.valor); }
 };
 
-// Nodo para �rbol AVL
+// Nodo para �rbol AVL aumentado con estadisticas del subarbol
 template <typename T>
 class NodoAVL {
 public:
@@ -30,8 +55,21 @@ public:
     NodoAVL<T>* izquierdo;
     NodoAVL<T>* derecho;
     int altura;
+    int tamanoSubarbol;   // nodos en este subarbol (incluido este)
+    double suma;          // suma de valores del subarbol
+    double sumaCuadrados; // suma de cuadrados (para varianza)
+    double minimo;
+    double maximo;
 
-    NodoAVL(T valor) : dato(valor), izquierdo(nullptr), derecho(nullptr), altura(1) {}
+    template <typename... Args>
+    explicit NodoAVL(Args&&... args)
+        : dato(std::forward<Args>(args)...), izquierdo(nullptr), derecho(nullptr), altura(1),
+          tamanoSubarbol(1) {
+        double v = ValorAgregado<T>::obtener(dato);
+        suma = v;
+        sumaCuadrados = v * v;
+        minimo = maximo = v;
+    }
 };
 
 #endif
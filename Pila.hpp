@@ -2,29 +2,45 @@
 #define PILA_HPP
 
 #include "Nodo.hpp"
+#include "AsignadorNodos.hpp"
+#include "Iteradores.hpp"
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-template <typename T>
+template <typename T, template <typename> class Asignador = AsignadorNew>
 class Pila {
 private:
     Nodo<T>* tope;
     int tamano;
+    Asignador<Nodo<T>> asignador;
+
+    void apilar(Nodo<T>* nuevo) {
+        nuevo->siguiente = tope;
+        tope = nuevo;
+        tamano++;
+    }
 
 public:
+    // Los iteradores recorren desde el tope hacia el fondo
+    typedef IteradorNodo<Nodo<T>, T> iterator;
+    typedef IteradorNodo<Nodo<T>, const T> const_iterator;
+
     Pila() : tope(nullptr), tamano(0) {}
 
     ~Pila() {
-        while (!estaVacia()) {
-            pop();
-        }
+        limpiar();
     }
 
     // Insertar elemento en el tope - O(1)
-    void push(T dato) {
-        Nodo<T>* nuevo = new Nodo<T>(dato);
-        nuevo->siguiente = tope;
-        tope = nuevo;
-        tamano++;
+    void push(const T& dato) { apilar(asignador.crear(dato)); }
+    void push(T&& dato) { apilar(asignador.crear(std::move(dato))); }
+
+    // Construir el elemento directamente en el tope - O(1)
+    template <typename... Args>
+    T& emplazar(Args&&... args) {
+        apilar(asignador.crear(std::forward<Args>(args)...));
+        return tope->dato;
     }
 
     // Eliminar y retornar elemento del tope - O(1)
@@ -33,15 +49,22 @@ public:
             throw std::runtime_error("Pila vacia");
         }
         Nodo<T>* temp = tope;
-        T dato = tope->dato;
+        T dato = std::move(tope->dato);
         tope = tope->siguiente;
-        delete temp;
+        asignador.destruir(temp);
         tamano--;
         return dato;
     }
 
     // Ver elemento del tope sin eliminarlo - O(1)
-    T top() const {
+    T& top() {
+        if (estaVacia()) {
+            throw std::runtime_error("Pila vacia");
+        }
+        return tope->dato;
+    }
+
+    const T& top() const {
         if (estaVacia()) {
             throw std::runtime_error("Pila vacia");
         }
@@ -56,11 +79,32 @@ public:
         return tamano;
     }
 
+    // Con una arena y T trivial se libera todo de golpe sin recorrer - O(1)
     void limpiar() {
-        while (!estaVacia()) {
-            pop();
+        if (Asignador<Nodo<T>>::liberacionMasiva && std::is_trivially_destructible<T>::value) {
+            asignador.reiniciar();
+        } else {
+            while (tope != nullptr) {
+                Nodo<T>* temp = tope;
+                tope = tope->siguiente;
+                asignador.destruir(temp);
+            }
+            asignador.reiniciar();
         }
+        tope = nullptr;
+        tamano = 0;
     }
+
+    const EstadisticasAsignador& getEstadisticasMemoria() const {
+        return asignador.getEstadisticas();
+    }
+
+    iterator begin() { return iterator(tope); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(tope); }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
 };
 
 #endif
@@ -0,0 +1,153 @@
+#ifndef PREDICADO_HPP
+#define PREDICADO_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Variables que pueden usar las condiciones de control, con indice fijo
+// Las condiciones se compilan a (indice, operador, umbral) una sola vez y se
+// evaluan contra un arreglo plano, sin buscar nombres en cada ciclo.
+enum VariableControl : uint8_t {
+    VAR_TEMP,
+    VAR_HUM_SUELO,
+    VAR_HUM_REL,
+    VAR_LUZ,
+    VAR_PH,
+    VAR_CO2,
+    VAR_AGUA,
+    VAR_TEMP_MEDIA,
+    VAR_TEMP_EMA,
+    VAR_TEMP_TASA,
+    VAR_HUM_SUELO_MEDIA,
+    VAR_HUM_SUELO_TASA,
+    VAR_HUM_REL_MEDIA,
+    NUM_VARIABLES_CONTROL
+};
+
+inline const char* nombreVariable(int variable) {
+    static const char* const nombres[NUM_VARIABLES_CONTROL] = {
+        "TEMP", "HUM_SUELO", "HUM_REL", "LUZ", "PH", "CO2", "AGUA",
+        "TEMP_MEDIA", "TEMP_EMA", "TEMP_TASA",
+        "HUM_SUELO_MEDIA", "HUM_SUELO_TASA", "HUM_REL_MEDIA"
+    };
+    return variable >= 0 && variable < NUM_VARIABLES_CONTROL ? nombres[variable] : "?";
+}
+
+// Indice de una variable por nombre; -1 si no existe - O(V)
+inline int buscarVariable(const std::string& nombre) {
+    for (int i = 0; i < NUM_VARIABLES_CONTROL; i++) {
+        if (nombre == nombreVariable(i)) return i;
+    }
+    return -1;
+}
+
+// Valores de todas las variables en un ciclo, indexados por VariableControl
+// Una variable sin dato vale NaN: toda comparacion contra ella es falsa,
+// igual que una condicion sobre un sensor ausente.
+struct ValoresControl {
+    double valores[NUM_VARIABLES_CONTROL];
+
+    ValoresControl() {
+        for (int i = 0; i < NUM_VARIABLES_CONTROL; i++) {
+            valores[i] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    double& operator[](int variable) { return valores[variable]; }
+    double operator[](int variable) const { return valores[variable]; }
+
+    // Conversion desde el formato por nombre (se ignoran nombres desconocidos)
+    static ValoresControl desdeMapa(const std::map<std::string, double>& mapa) {
+        ValoresControl v;
+        for (const auto& par : mapa) {
+            int variable = buscarVariable(par.first);
+            if (variable >= 0) v.valores[variable] = par.second;
+        }
+        return v;
+    }
+
+    std::map<std::string, double> aMapa() const {
+        std::map<std::string, double> mapa;
+        for (int i = 0; i < NUM_VARIABLES_CONTROL; i++) {
+            if (!std::isnan(valores[i])) mapa[nombreVariable(i)] = valores[i];
+        }
+        return mapa;
+    }
+};
+
+// Condicion compilada "VARIABLE op UMBRAL" con op en { <, >, = }
+struct Predicado {
+    uint8_t variable;
+    char operador;
+    double umbral;
+
+    Predicado() : variable(VAR_TEMP), operador('>'), umbral(std::numeric_limits<double>::infinity()) {}
+
+    Predicado(uint8_t _variable, char _operador, double _umbral)
+        : variable(_variable), operador(_operador), umbral(_umbral) {}
+
+    // Compilar una condicion de texto como "TEMP>35" - lanza invalid_argument
+    static Predicado compilar(const std::string& condicion) {
+        size_t posOperador = condicion.find_first_of("<>=");
+        if (posOperador == std::string::npos) {
+            throw std::invalid_argument("Condicion sin operador: " + condicion);
+        }
+
+        std::string nombre = condicion.substr(0, posOperador);
+        nombre.erase(0, nombre.find_first_not_of(" \t"));
+        nombre.erase(nombre.find_last_not_of(" \t") + 1);
+        int variable = buscarVariable(nombre);
+        if (variable < 0) {
+            throw std::invalid_argument("Variable desconocida: " + nombre);
+        }
+
+        std::string texto = condicion.substr(posOperador + 1);
+        size_t leidos = 0;
+        double umbral;
+        try {
+            umbral = std::stod(texto, &leidos);
+        } catch (const std::exception&) {
+            throw std::invalid_argument("Umbral invalido: " + condicion);
+        }
+        if (texto.find_first_not_of(" \t", leidos) != std::string::npos) {
+            throw std::invalid_argument("Umbral invalido: " + condicion);
+        }
+        return Predicado((uint8_t)variable, condicion[posOperador], umbral);
+    }
+
+    // Evaluar contra los valores del ciclo - O(1), sin asignaciones
+    bool evaluar(const ValoresControl& v) const {
+        double valor = v[variable];
+        switch (operador) {
+            case '>': return valor > umbral;
+            case '<': return valor < umbral;
+            case '=': return std::abs(valor - umbral) < 0.1;
+            default: return false;
+        }
+    }
+
+    // Igual que evaluar pero con el umbral corrido 'holgura' a favor de la
+    // condicion (banda de histeresis para mantenerla ya cumplida) - O(1)
+    bool evaluar(const ValoresControl& v, double holgura) const {
+        double valor = v[variable];
+        switch (operador) {
+            case '>': return valor > umbral - holgura;
+            case '<': return valor < umbral + holgura;
+            case '=': return std::abs(valor - umbral) < 0.1 + holgura;
+            default: return false;
+        }
+    }
+
+    std::string texto() const {
+        std::ostringstream salida;
+        salida << nombreVariable(variable) << operador << umbral;
+        return salida.str();
+    }
+};
+
+#endif
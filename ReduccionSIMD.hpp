@@ -0,0 +1,232 @@
+#ifndef REDUCCION_SIMD_HPP
+#define REDUCCION_SIMD_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+// Las variantes vectoriales usan atributos target de GCC/Clang y se eligen en
+// tiempo de ejecucion segun la CPU. En otros compiladores (MSVC) o
+// arquitecturas solo se compila la version escalar.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define REDUCCION_SIMD_X86 1
+#endif
+
+// Resultado de una reduccion: mismos campos que AcumuladorEstadistico
+struct Momentos {
+    long cantidad;
+    double media;
+    double m2;      // suma de cuadrados de las desviaciones a la media
+    double minimo;
+    double maximo;
+};
+
+// Reduccion fusionada de una pasada: cantidad, media, M2, minimo y maximo
+// Los datos se procesan en bloques que caben en cache; en cada bloque se
+// acumulan por carril sum(x - c) y sum((x - c)^2) respecto de c = primer
+// dato del bloque (evita la cancelacion de sumar cuadrados crudos), junto
+// con min y max. Los bloques se combinan con la formula de Chan.
+class ReduccionSIMD {
+private:
+    static const size_t BLOQUE = 4096;
+
+    enum Nivel { ESCALAR, SSE2, AVX2 };
+
+    struct Sumas {
+        double s1;
+        double s2;
+        double minimo;
+        double maximo;
+    };
+
+    template <typename T>
+    static void sumasEscalar(const T* datos, size_t n, double centro, Sumas& s) {
+        for (size_t i = 0; i < n; i++) {
+            double x = datos[i];
+            double d = x - centro;
+            s.s1 += d;
+            s.s2 += d * d;
+            if (x < s.minimo) s.minimo = x;
+            if (x > s.maximo) s.maximo = x;
+        }
+    }
+
+#ifdef REDUCCION_SIMD_X86
+    __attribute__((target("sse2")))
+    static void sumasSSE2(const double* datos, size_t n, double centro, Sumas& s) {
+        __m128d c = _mm_set1_pd(centro);
+        __m128d s1 = _mm_setzero_pd(), s2 = _mm_setzero_pd();
+        __m128d lo = _mm_set1_pd(s.minimo), hi = _mm_set1_pd(s.maximo);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128d x = _mm_loadu_pd(datos + i);
+            __m128d d = _mm_sub_pd(x, c);
+            s1 = _mm_add_pd(s1, d);
+            s2 = _mm_add_pd(s2, _mm_mul_pd(d, d));
+            lo = _mm_min_pd(lo, x);
+            hi = _mm_max_pd(hi, x);
+        }
+        reducir(s1, s2, lo, hi, s);
+        sumasEscalar(datos + i, n - i, centro, s);
+    }
+
+    __attribute__((target("sse2")))
+    static void sumasSSE2(const float* datos, size_t n, double centro, Sumas& s) {
+        __m128d c = _mm_set1_pd(centro);
+        __m128d s1 = _mm_setzero_pd(), s2 = _mm_setzero_pd();
+        __m128d lo = _mm_set1_pd(s.minimo), hi = _mm_set1_pd(s.maximo);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            // Dos float a double: se acumula en doble precision
+            __m128d x = _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd((const double*)(datos + i))));
+            __m128d d = _mm_sub_pd(x, c);
+            s1 = _mm_add_pd(s1, d);
+            s2 = _mm_add_pd(s2, _mm_mul_pd(d, d));
+            lo = _mm_min_pd(lo, x);
+            hi = _mm_max_pd(hi, x);
+        }
+        reducir(s1, s2, lo, hi, s);
+        sumasEscalar(datos + i, n - i, centro, s);
+    }
+
+    __attribute__((target("sse2")))
+    static void reducir(__m128d s1, __m128d s2, __m128d lo, __m128d hi, Sumas& s) {
+        double a[2], b[2], l[2], h[2];
+        _mm_storeu_pd(a, s1);
+        _mm_storeu_pd(b, s2);
+        _mm_storeu_pd(l, lo);
+        _mm_storeu_pd(h, hi);
+        s.s1 += a[0] + a[1];
+        s.s2 += b[0] + b[1];
+        s.minimo = std::min(s.minimo, std::min(l[0], l[1]));
+        s.maximo = std::max(s.maximo, std::max(h[0], h[1]));
+    }
+
+    __attribute__((target("avx2")))
+    static void sumasAVX2(const double* datos, size_t n, double centro, Sumas& s) {
+        __m256d c = _mm256_set1_pd(centro);
+        __m256d s1 = _mm256_setzero_pd(), s2 = _mm256_setzero_pd();
+        __m256d lo = _mm256_set1_pd(s.minimo), hi = _mm256_set1_pd(s.maximo);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d x = _mm256_loadu_pd(datos + i);
+            __m256d d = _mm256_sub_pd(x, c);
+            s1 = _mm256_add_pd(s1, d);
+            s2 = _mm256_add_pd(s2, _mm256_mul_pd(d, d));
+            lo = _mm256_min_pd(lo, x);
+            hi = _mm256_max_pd(hi, x);
+        }
+        reducir(s1, s2, lo, hi, s);
+        sumasEscalar(datos + i, n - i, centro, s);
+    }
+
+    __attribute__((target("avx2")))
+    static void sumasAVX2(const float* datos, size_t n, double centro, Sumas& s) {
+        __m256d c = _mm256_set1_pd(centro);
+        __m256d s1 = _mm256_setzero_pd(), s2 = _mm256_setzero_pd();
+        __m256d lo = _mm256_set1_pd(s.minimo), hi = _mm256_set1_pd(s.maximo);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d x = _mm256_cvtps_pd(_mm_loadu_ps(datos + i));
+            __m256d d = _mm256_sub_pd(x, c);
+            s1 = _mm256_add_pd(s1, d);
+            s2 = _mm256_add_pd(s2, _mm256_mul_pd(d, d));
+            lo = _mm256_min_pd(lo, x);
+            hi = _mm256_max_pd(hi, x);
+        }
+        reducir(s1, s2, lo, hi, s);
+        sumasEscalar(datos + i, n - i, centro, s);
+    }
+
+    __attribute__((target("avx2")))
+    static void reducir(__m256d s1, __m256d s2, __m256d lo, __m256d hi, Sumas& s) {
+        double a[4], b[4], l[4], h[4];
+        _mm256_storeu_pd(a, s1);
+        _mm256_storeu_pd(b, s2);
+        _mm256_storeu_pd(l, lo);
+        _mm256_storeu_pd(h, hi);
+        for (int j = 0; j < 4; j++) {
+            s.s1 += a[j];
+            s.s2 += b[j];
+            s.minimo = std::min(s.minimo, l[j]);
+            s.maximo = std::max(s.maximo, h[j]);
+        }
+    }
+#endif
+
+    // Conjunto de instrucciones disponible, consultado una sola vez
+    static Nivel nivel() {
+#ifdef REDUCCION_SIMD_X86
+        static const Nivel detectado =
+            __builtin_cpu_supports("avx2") ? AVX2 : (__builtin_cpu_supports("sse2") ? SSE2 : ESCALAR);
+        return detectado;
+#else
+        return ESCALAR;
+#endif
+    }
+
+    template <typename T>
+    static void sumas(const T* datos, size_t n, double centro, Sumas& s) {
+#ifdef REDUCCION_SIMD_X86
+        switch (nivel()) {
+            case AVX2: sumasAVX2(datos, n, centro, s); return;
+            case SSE2: sumasSSE2(datos, n, centro, s); return;
+            default: break;
+        }
+#endif
+        sumasEscalar(datos, n, centro, s);
+    }
+
+    // Unir un bloque al total (Chan et al.) - O(1)
+    static void combinar(Momentos& total, const Momentos& bloque) {
+        if (total.cantidad == 0) {
+            total = bloque;
+            return;
+        }
+        long n = total.cantidad + bloque.cantidad;
+        double delta = bloque.media - total.media;
+        total.media += delta * bloque.cantidad / n;
+        total.m2 += bloque.m2 + delta * delta * ((double)total.cantidad * bloque.cantidad / n);
+        total.cantidad = n;
+        total.minimo = std::min(total.minimo, bloque.minimo);
+        total.maximo = std::max(total.maximo, bloque.maximo);
+    }
+
+    template <typename T>
+    static Momentos resumirGenerico(const T* datos, size_t n) {
+        Momentos total = {0, 0.0, 0.0,
+                          std::numeric_limits<double>::infinity(),
+                          -std::numeric_limits<double>::infinity()};
+        for (size_t inicio = 0; inicio < n; inicio += BLOQUE) {
+            size_t tam = n - inicio < BLOQUE ? n - inicio : BLOQUE;
+            double centro = datos[inicio];
+            Sumas s = {0.0, 0.0, total.minimo, total.maximo};
+            sumas(datos + inicio, tam, centro, s);
+
+            Momentos bloque;
+            bloque.cantidad = (long)tam;
+            bloque.media = centro + s.s1 / tam;
+            bloque.m2 = std::max(0.0, s.s2 - s.s1 * s.s1 / tam);
+            bloque.minimo = s.minimo;
+            bloque.maximo = s.maximo;
+            combinar(total, bloque);
+        }
+        return total;
+    }
+
+public:
+    // Reducir n datos contiguos en una sola pasada - O(n), vectorizado
+    static Momentos resumir(const double* datos, size_t n) { return resumirGenerico(datos, n); }
+    static Momentos resumir(const float* datos, size_t n) { return resumirGenerico(datos, n); }
+
+    static const char* conjuntoInstrucciones() {
+        switch (nivel()) {
+            case AVX2: return "AVX2";
+            case SSE2: return "SSE2";
+            default: return "escalar";
+        }
+    }
+};
+
+#endif
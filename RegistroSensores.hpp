@@ -0,0 +1,74 @@
+#ifndef REGISTRO_SENSORES_HPP
+#define REGISTRO_SENSORES_HPP
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+// Tabla global de identificadores de sensor internados
+// Cada nombre ("TEMP", "HUM_SUELO", ...) recibe un id de 16 bits una sola vez,
+// al crear el sensor; las lecturas guardan solo ese id y el nombre se recupera
+// al mostrar. El id 0 queda reservado para "ningun sensor" (cotas de busqueda).
+class RegistroSensores {
+private:
+    std::mutex mutex;
+    std::deque<std::string> nombres;    // deque: las referencias no se invalidan al crecer
+    std::map<std::string, uint16_t> ids;
+
+    RegistroSensores() {
+        nombres.push_back("");
+        ids[""] = 0;
+    }
+
+    static RegistroSensores& instancia() {
+        static RegistroSensores registro;
+        return registro;
+    }
+
+public:
+    static const uint16_t SIN_SENSOR = 0;
+
+    // Obtener el id de un nombre, registrandolo si es nuevo - O(log n)
+    static uint16_t registrar(const std::string& nombre) {
+        RegistroSensores& r = instancia();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto it = r.ids.find(nombre);
+        if (it != r.ids.end()) return it->second;
+        if (r.nombres.size() > UINT16_MAX) {
+            throw std::runtime_error("Demasiados sensores registrados");
+        }
+        uint16_t id = (uint16_t)r.nombres.size();
+        r.nombres.push_back(nombre);
+        r.ids[nombre] = id;
+        return id;
+    }
+
+    // Id de un nombre ya registrado, o SIN_SENSOR - O(log n)
+    static uint16_t buscar(const std::string& nombre) {
+        RegistroSensores& r = instancia();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto it = r.ids.find(nombre);
+        return it != r.ids.end() ? it->second : SIN_SENSOR;
+    }
+
+    // Nombre de un id (solo para mostrar) - O(1)
+    static const std::string& nombre(uint16_t id) {
+        RegistroSensores& r = instancia();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (id >= r.nombres.size()) {
+            throw std::out_of_range("Id de sensor desconocido");
+        }
+        return r.nombres[id];
+    }
+
+    static int getCantidad() {
+        RegistroSensores& r = instancia();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        return (int)r.nombres.size() - 1;
+    }
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef RELOJ_HPP
+#define RELOJ_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+
+// Fuente de tiempo inyectable para sensores y ciclo de control
+// Los sensores preguntan la hora del dia a un Reloj en vez de llamar a
+// time()/localtime() en cada lectura; en pruebas y simulaciones se usa un
+// RelojSimulado para que las corridas sean reproducibles.
+class Reloj {
+public:
+    virtual ~Reloj() {}
+
+    // Milisegundos desde la epoca Unix (UTC)
+    virtual int64_t ahoraMs() const = 0;
+
+    // Desplazamiento de la hora local respecto de UTC, en segundos
+    virtual int64_t desfaseLocalSeg() const = 0;
+
+    // Hora local del dia [0, 23] sin consultar la zona horaria de libc - O(1)
+    int horaDelDia() const {
+        int64_t seg = ahoraMs() / 1000 + desfaseLocalSeg();
+        int64_t delDia = seg % 86400;
+        if (delDia < 0) delDia += 86400;
+        return (int)(delDia / 3600);
+    }
+};
+
+// Reloj del sistema con el desfase de zona horaria en cache
+// localtime() solo se consulta al crear el reloj y luego como maximo una vez
+// por hora (cambios de horario de verano); el resto son lecturas atomicas.
+class RelojSistema : public Reloj {
+private:
+    mutable std::atomic<int64_t> desfase;
+    mutable std::atomic<int64_t> proximaActualizacionMs;
+    mutable std::mutex mutex;
+
+    static int64_t ahoraSistemaMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Unica llamada a la zona horaria de libc (protegida: localtime no es reentrante)
+    void actualizarDesfase(int64_t ahora) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ahora < proximaActualizacionMs.load(std::memory_order_relaxed)) return;
+        time_t t = (time_t)(ahora / 1000);
+        struct tm local = *localtime(&t);
+        struct tm utc = *gmtime(&t);
+        int dias = local.tm_yday - utc.tm_yday;
+        if (dias > 1) dias = -1;       // cambio de anio
+        else if (dias < -1) dias = 1;
+        int64_t seg = (int64_t)dias * 86400
+                    + (local.tm_hour - utc.tm_hour) * 3600
+                    + (local.tm_min - utc.tm_min) * 60
+                    + (local.tm_sec - utc.tm_sec);
+        desfase.store(seg, std::memory_order_relaxed);
+        proximaActualizacionMs.store(ahora + 3600 * 1000, std::memory_order_release);
+    }
+
+public:
+    RelojSistema() : desfase(0), proximaActualizacionMs(0) {
+        actualizarDesfase(ahoraSistemaMs());
+    }
+
+    int64_t ahoraMs() const override {
+        return ahoraSistemaMs();
+    }
+
+    int64_t desfaseLocalSeg() const override {
+        int64_t ahora = ahoraSistemaMs();
+        if (ahora >= proximaActualizacionMs.load(std::memory_order_acquire)) {
+            actualizarDesfase(ahora);
+        }
+        return desfase.load(std::memory_order_relaxed);
+    }
+
+    // Instancia compartida por defecto
+    static RelojSistema& global() {
+        static RelojSistema reloj;
+        return reloj;
+    }
+};
+
+// Reloj manual: el tiempo solo avanza cuando se pide (simulacion, pruebas)
+class RelojSimulado : public Reloj {
+private:
+    std::atomic<int64_t> actualMs;
+    int64_t desfase;
+
+public:
+    explicit RelojSimulado(int64_t inicioMs = 0, int64_t _desfaseSeg = 0)
+        : actualMs(inicioMs), desfase(_desfaseSeg) {}
+
+    int64_t ahoraMs() const override { return actualMs.load(std::memory_order_acquire); }
+    int64_t desfaseLocalSeg() const override { return desfase; }
+
+    void avanzar(int64_t ms) { actualMs.fetch_add(ms, std::memory_order_acq_rel); }
+    void establecer(int64_t ms) { actualMs.store(ms, std::memory_order_release); }
+};
+
+#endif
@@ -1,303 +1,296 @@
 #ifndef SENSOR_HPP
 #define SENSOR_HPP
 
+#include "Lectura.hpp"
+#include "GeneradorAleatorio.hpp"
+#include "Reloj.hpp"
 #include <string>
-#include <cstdlib>
-#include <ctime>
 #include <cmath>
-#include <random>
 
-// Clase base abstracta para sensores
-class Sensor {
+// Especificacion de cada tipo de sensor, fija en tiempo de compilacion
+// Rango y umbrales son constantes, asi que evaluarEstado() se reduce a
+// comparaciones contra inmediatos y el piso critico se calcula al compilar.
+struct RasgosTemperatura {
+    static constexpr const char* tipo = "Temperatura";
+    static constexpr const char* unidad = "°C";
+    static constexpr double rangoMin = 0.0;
+    static constexpr double rangoMax = 50.0;
+    static constexpr double umbralAlerta = 35.0;
+    static constexpr double umbralCritico = 40.0;
+};
+
+struct RasgosHumedad {
+    static constexpr const char* tipo = "Humedad";
+    static constexpr const char* unidad = "%";
+    static constexpr double rangoMin = 0.0;
+    static constexpr double rangoMax = 100.0;
+    static constexpr double umbralAlerta = 85.0;
+    static constexpr double umbralCritico = 95.0;
+};
+
+struct RasgosLuz {
+    static constexpr const char* tipo = "Luz";
+    static constexpr const char* unidad = "Lux";
+    static constexpr double rangoMin = 0.0;
+    static constexpr double rangoMax = 100000.0;
+    static constexpr double umbralAlerta = 80000.0;
+    static constexpr double umbralCritico = 95000.0;
+};
+
+struct RasgosPH {
+    static constexpr const char* tipo = "pH";
+    static constexpr const char* unidad = "pH";
+    static constexpr double rangoMin = 0.0;
+    static constexpr double rangoMax = 14.0;
+    static constexpr double umbralAlerta = 8.0;
+    static constexpr double umbralCritico = 9.0;
+};
+
+struct RasgosCO2 {
+    static constexpr const char* tipo = "CO2";
+    static constexpr const char* unidad = "ppm";
+    static constexpr double rangoMin = 0.0;
+    static constexpr double rangoMax = 2000.0;
+    static constexpr double umbralAlerta = 1200.0;
+    static constexpr double umbralCritico = 1800.0;
+};
+
+struct RasgosNivelAgua {
+    static constexpr const char* tipo = "Nivel Agua";
+    static constexpr const char* unidad = "L";
+    static constexpr double rangoMin = 0.0;
+    static constexpr double rangoMax = 1000.0;
+    static constexpr double umbralAlerta = 200.0;
+    static constexpr double umbralCritico = 50.0;
+};
+
+// Base CRTP comun a todos los sensores
+// leer() llama a Derivado::simularPaso() sin pasar por la vtable y luego
+// limita el valor al rango del tipo; getters y evaluacion se declaran una
+// sola vez aqui y el compilador puede expandirlos en linea.
+template <typename Derivado, typename Rasgos>
+class SensorEstatico {
 protected:
     std::string id;
-    std::string tipo;
-    std::string unidad;
+    uint16_t idInterno;           // id compacto usado en las lecturas
     double valorActual;
-    double rangoMin;
-    double rangoMax;
-    double umbralAlerta;
-    double umbralCritico;
-    double tasaEvaporacion;  // para simular evaporación más realista
-    double tasaConsumo;      // para consumo de agua/nutrientes
+    GeneradorAleatorio generador; // ruido propio de cada sensor
+    const Reloj* reloj;           // fuente de la hora del dia
+
+    static constexpr double pisoCritico =
+        Rasgos::rangoMin + (Rasgos::rangoMax - Rasgos::rangoMin) * 0.05;
+
+    static double limitar(double valor) {
+        if (valor < Rasgos::rangoMin) return Rasgos::rangoMin;
+        if (valor > Rasgos::rangoMax) return Rasgos::rangoMax;
+        return valor;
+    }
+
+    // Sumar un ajuste externo (actuadores) sin salir del rango - O(1)
+    void desplazar(double ajuste) {
+        valorActual = limitar(valorActual + ajuste);
+    }
+
+    // Punto de personalizacion: un derivado puede ocultarlo
+    const char* tipoSensor() const { return Rasgos::tipo; }
 
 public:
-    Sensor(std::string _id, std::string _tipo, std::string _unidad, 
-           double _min, double _max, double _alerta, double _critico)
-        : id(_id), tipo(_tipo), unidad(_unidad), valorActual(0),
-          rangoMin(_min), rangoMax(_max), umbralAlerta(_alerta), 
-          umbralCritico(_critico), tasaEvaporacion(0.0), tasaConsumo(0.0) {}
+    typedef Rasgos TipoRasgos;
 
-    virtual ~Sensor() {}
+    SensorEstatico(const std::string& _id, double valorInicial)
+        : id(_id), idInterno(RegistroSensores::registrar(_id)), valorActual(valorInicial),
+          generador(GeneradorAleatorio::semillaDe(_id)), reloj(&RelojSistema::global()) {}
 
-    // Método virtual puro para leer sensor (simulado)
-    virtual double leer() = 0;
+    // Leer sensor (simulado) con despacho estatico
+    double leer() {
+        static_cast<Derivado*>(this)->simularPaso();
+        valorActual = limitar(valorActual);
+        return valorActual;
+    }
 
-    std::string getID() const { return id; }
-    std::string getTipo() const { return tipo; }
-    std::string getUnidad() const { return unidad; }
-    double getValorActual() const { return valorActual; }
-    double getRangoMin() const { return rangoMin; }
-    double getRangoMax() const { return rangoMax; }
-
-    std::string evaluarEstado() {
-        if (valorActual >= umbralCritico || valorActual <= (rangoMin + (rangoMax - rangoMin) * 0.05))
-            return "critico";
-        else if (valorActual >= umbralAlerta)
-            return "alerta";
-        return "normal";
+    EstadoLectura evaluarEstado() const {
+        if (valorActual >= Rasgos::umbralCritico || valorActual <= pisoCritico)
+            return ESTADO_CRITICO;
+        else if (valorActual >= Rasgos::umbralAlerta)
+            return ESTADO_ALERTA;
+        return ESTADO_NORMAL;
     }
+
+    // Reiniciar el ruido desde una semilla (corridas reproducibles)
+    void sembrar(uint64_t semilla) { generador.sembrar(semilla ^ GeneradorAleatorio::semillaDe(id)); }
+
+    void setReloj(const Reloj* _reloj) { reloj = _reloj; }
+
+    const std::string& getID() const { return id; }
+    uint16_t getIdInterno() const { return idInterno; }
+    std::string getTipo() const { return static_cast<const Derivado*>(this)->tipoSensor(); }
+    std::string getUnidad() const { return Rasgos::unidad; }
+    double getValorActual() const { return valorActual; }
+    static constexpr double getRangoMin() { return Rasgos::rangoMin; }
+    static constexpr double getRangoMax() { return Rasgos::rangoMax; }
 };
 
 // Sensor de temperatura mejorado
-class SensorTemperatura : public Sensor {
+class SensorTemperatura : public SensorEstatico<SensorTemperatura, RasgosTemperatura> {
 private:
     double deriva;
-    double cicloAmbiente;  // para simular día/noche
 
 public:
-    SensorTemperatura(std::string _id, double tempInicial = 25.0)
-        : Sensor(_id, "Temperatura", "°C", 0.0, 50.0, 35.0, 40.0), 
-          deriva(0), cicloAmbiente(0) {
-        valorActual = tempInicial;
-        srand(time(nullptr));
-    }
+    SensorTemperatura(const std::string& _id, double tempInicial = 25.0)
+        : SensorEstatico(_id, tempInicial), deriva(0) {}
+
+    void simularPaso() {
+        int hora = reloj->horaDelDia();
 
-    double leer() override {
-        time_t ahora = time(nullptr);
-        struct tm* tiempo = localtime(&ahora);
-        int hora = tiempo->tm_hour;
-        
         // Ciclo día/noche: más calor durante el día
         double cicloTemp = 5.0 * sin((hora - 6) * 3.14159 / 12.0);
         if (hora < 6 || hora > 18) cicloTemp = -3.0;
-        
-        double variacion = ((rand() % 100) - 50) / 100.0;
-        deriva += ((rand() % 100) - 50) / 1000.0;
-        
-        valorActual += (cicloTemp * 0.01) + variacion + (deriva * 0.5);
 
-        if (valorActual < rangoMin) valorActual = rangoMin;
-        if (valorActual > rangoMax) valorActual = rangoMax;
+        double variacion = ((int)generador.entero(100) - 50) / 100.0;
+        deriva += ((int)generador.entero(100) - 50) / 1000.0;
 
-        return valorActual;
-    }
-
-    std::string getID() const { return id; }
-    std::string getTipo() const { return tipo; }
-    std::string getUnidad() const { return unidad; }
-    double getValorActual() const { return valorActual; }
-    double getRangoMin() const { return rangoMin; }
-    double getRangoMax() const { return rangoMax; }
-
-    std::string evaluarEstado() {
-        if (valorActual >= umbralCritico || valorActual <= (rangoMin + (rangoMax - rangoMin) * 0.05))
-            return "critico";
-        else if (valorActual >= umbralAlerta)
-            return "alerta";
-        return "normal";
+        valorActual += (cicloTemp * 0.01) + variacion + (deriva * 0.5);
     }
 
     void aplicarControlCalor(double ajuste) {
-        valorActual += ajuste;
-        if (valorActual < rangoMin) valorActual = rangoMin;
-        if (valorActual > rangoMax) valorActual = rangoMax;
+        desplazar(ajuste);
     }
 };
 
-// Sensor de humedad mejorado
-class SensorHumedad : public Sensor {
+// Sensor de humedad mejorado (de suelo o relativa, mismo rango y umbrales)
+class SensorHumedad : public SensorEstatico<SensorHumedad, RasgosHumedad> {
+    friend class SensorEstatico<SensorHumedad, RasgosHumedad>;
+
 private:
     double tasaEvaporacionBase;
     bool esSuelo;
 
+    const char* tipoSensor() const { return esSuelo ? "Humedad Suelo" : "Humedad Relativa"; }
+
 public:
-    SensorHumedad(std::string _id, double humInicial = 70.0, bool _esSuelo = false)
-        : Sensor(_id, _esSuelo ? "Humedad Suelo" : "Humedad Relativa", "%", 
-                 0.0, 100.0, 85.0, 95.0), tasaEvaporacionBase(0.15), esSuelo(_esSuelo) {
-        valorActual = humInicial;
-    }
+    SensorHumedad(const std::string& _id, double humInicial = 70.0, bool _esSuelo = false)
+        : SensorEstatico(_id, humInicial), tasaEvaporacionBase(0.15), esSuelo(_esSuelo) {}
 
-    double leer() override {
+    void simularPaso() {
         double factor = esSuelo ? 0.08 : 0.12;
-        double variacion = ((rand() % 100) - 50) / 200.0;
+        double variacion = ((int)generador.entero(100) - 50) / 200.0;
         valorActual -= (tasaEvaporacionBase * factor) + variacion;
-
-        if (valorActual < rangoMin) valorActual = rangoMin;
-        if (valorActual > rangoMax) valorActual = rangoMax;
-
-        return valorActual;
-    }
-
-    std::string getID() const { return id; }
-    std::string getTipo() const { return tipo; }
-    std::string getUnidad() const { return unidad; }
-    double getValorActual() const { return valorActual; }
-    double getRangoMin() const { return rangoMin; }
-    double getRangoMax() const { return rangoMax; }
-
-    std::string evaluarEstado() {
-        if (valorActual >= umbralCritico || valorActual <= (rangoMin + (rangoMax - rangoMin) * 0.05))
-            return "critico";
-        else if (valorActual >= umbralAlerta)
-            return "alerta";
-        return "normal";
     }
 
     void aplicarRiego(double cantidad) {
-        valorActual += cantidad;
-        if (valorActual > rangoMax) valorActual = rangoMax;
+        desplazar(cantidad);
     }
 };
 
 // Sensor de luz mejorado
-class SensorLuz : public Sensor {
+class SensorLuz : public SensorEstatico<SensorLuz, RasgosLuz> {
 public:
-    SensorLuz(std::string _id, double luzInicial = 45000.0)
-        : Sensor(_id, "Luz", "Lux", 0.0, 100000.0, 80000.0, 95000.0) {
-        valorActual = luzInicial;
-    }
+    SensorLuz(const std::string& _id, double luzInicial = 45000.0)
+        : SensorEstatico(_id, luzInicial) {}
 
-    double leer() override {
-        time_t ahora = time(nullptr);
-        struct tm* tiempo = localtime(&ahora);
-        int hora = tiempo->tm_hour;
+    void simularPaso() {
+        int hora = reloj->horaDelDia();
 
         if (hora >= 6 && hora <= 18) {
             int cicloHora = hora - 6;
             // Máximo al mediodía (hora 12)
             double factorLuz = sin((cicloHora * 3.14159) / 12.0);
-            valorActual = 20000 + (factorLuz * 50000) + (rand() % 5000);
+            valorActual = 20000 + (factorLuz * 50000) + generador.entero(5000);
         } else {
-            valorActual = rand() % 2000;  // Luz nocturna mínima
+            valorActual = generador.entero(2000);  // Luz nocturna mínima
         }
-
-        return valorActual;
-    }
-
-    std::string getID() const { return id; }
-    std::string getTipo() const { return tipo; }
-    std::string getUnidad() const { return unidad; }
-    double getValorActual() const { return valorActual; }
-    double getRangoMin() const { return rangoMin; }
-    double getRangoMax() const { return rangoMax; }
-
-    std::string evaluarEstado() {
-        if (valorActual >= umbralCritico || valorActual <= (rangoMin + (rangoMax - rangoMin) * 0.05))
-            return "critico";
-        else if (valorActual >= umbralAlerta)
-            return "alerta";
-        return "normal";
     }
 };
 
 // Sensor de pH
-class SensorPH : public Sensor {
+class SensorPH : public SensorEstatico<SensorPH, RasgosPH> {
 public:
-    SensorPH(std::string _id, double phInicial = 6.5)
-        : Sensor(_id, "pH", "pH", 0.0, 14.0, 8.0, 9.0) {
-        valorActual = phInicial;
-    }
+    SensorPH(const std::string& _id, double phInicial = 6.5)
+        : SensorEstatico(_id, phInicial) {}
 
-    double leer() override {
+    void simularPaso() {
         // Simulación: cambios muy lentos
-        double variacion = ((rand() % 100) - 50) / 500.0;
-        valorActual += variacion;
-
-        if (valorActual < rangoMin) valorActual = rangoMin;
-        if (valorActual > rangoMax) valorActual = rangoMax;
-
-        return valorActual;
-    }
-
-    std::string getID() const { return id; }
-    std::string getTipo() const { return tipo; }
-    std::string getUnidad() const { return unidad; }
-    double getValorActual() const { return valorActual; }
-    double getRangoMin() const { return rangoMin; }
-    double getRangoMax() const { return rangoMax; }
-
-    std::string evaluarEstado() {
-        if (valorActual >= umbralCritico || valorActual <= (rangoMin + (rangoMax - rangoMin) * 0.05))
-            return "critico";
-        else if (valorActual >= umbralAlerta)
-            return "alerta";
-        return "normal";
+        valorActual += ((int)generador.entero(100) - 50) / 500.0;
     }
 };
 
 // Sensor de CO2
-class SensorCO2 : public Sensor {
+class SensorCO2 : public SensorEstatico<SensorCO2, RasgosCO2> {
 public:
-    SensorCO2(std::string _id, double co2Inicial = 450.0)
-        : Sensor(_id, "CO2", "ppm", 0.0, 2000.0, 1200.0, 1800.0) {
-        valorActual = co2Inicial;
-    }
-
-    double leer() override {
-        double variacion = ((rand() % 100) - 50) / 10.0;
-        valorActual += variacion;
+    SensorCO2(const std::string& _id, double co2Inicial = 450.0)
+        : SensorEstatico(_id, co2Inicial) {}
 
-        if (valorActual < rangoMin) valorActual = rangoMin;
-        if (valorActual > rangoMax) valorActual = rangoMax;
-
-        return valorActual;
-    }
-
-    std::string getID() const { return id; }
-    std::string getTipo() const { return tipo; }
-    std::string getUnidad() const { return unidad; }
-    double getValorActual() const { return valorActual; }
-    double getRangoMin() const { return rangoMin; }
-    double getRangoMax() const { return rangoMax; }
-
-    std::string evaluarEstado() {
-        if (valorActual >= umbralCritico || valorActual <= (rangoMin + (rangoMax - rangoMin) * 0.05))
-            return "critico";
-        else if (valorActual >= umbralAlerta)
-            return "alerta";
-        return "normal";
+    void simularPaso() {
+        valorActual += ((int)generador.entero(100) - 50) / 10.0;
     }
 };
 
 // Sensor de nivel de agua
-class SensorNivelAgua : public Sensor {
+class SensorNivelAgua : public SensorEstatico<SensorNivelAgua, RasgosNivelAgua> {
 private:
     double consumo;
 
 public:
-    SensorNivelAgua(std::string _id, double nivelInicial = 500.0)
-        : Sensor(_id, "Nivel Agua", "L", 0.0, 1000.0, 200.0, 50.0), consumo(0.5) {
-        valorActual = nivelInicial;
-    }
+    SensorNivelAgua(const std::string& _id, double nivelInicial = 500.0)
+        : SensorEstatico(_id, nivelInicial), consumo(0.5) {}
 
-    double leer() override {
+    void simularPaso() {
         // Simulación: consumo gradual
         valorActual -= consumo;
-        if (valorActual < rangoMin) valorActual = rangoMin;
-
-        return valorActual;
     }
 
     void rellenar(double cantidad) {
-        valorActual += cantidad;
-        if (valorActual > rangoMax) valorActual = rangoMax;
+        desplazar(cantidad);
     }
+};
 
-    std::string getID() const { return id; }
-    std::string getTipo() const { return tipo; }
-    std::string getUnidad() const { return unidad; }
-    double getValorActual() const { return valorActual; }
-    double getRangoMin() const { return rangoMin; }
-    double getRangoMax() const { return rangoMax; }
-
-    std::string evaluarEstado() {
-        if (valorActual >= umbralCritico || valorActual <= (rangoMin + (rangoMax - rangoMin) * 0.05))
-            return "critico";
-        else if (valorActual >= umbralAlerta)
-            return "alerta";
-        return "normal";
-    }
+// Interfaz dinamica para tratar sensores heterogeneos de forma uniforme
+// (configuracion, listados). El ciclo de control usa los tipos concretos.
+class Sensor {
+public:
+    virtual ~Sensor() {}
+
+    virtual double leer() = 0;
+    virtual EstadoLectura evaluarEstado() const = 0;
+    virtual void sembrar(uint64_t semilla) = 0;
+    virtual void setReloj(const Reloj* reloj) = 0;
+
+    virtual const std::string& getID() const = 0;
+    virtual uint16_t getIdInterno() const = 0;
+    virtual std::string getTipo() const = 0;
+    virtual std::string getUnidad() const = 0;
+    virtual double getValorActual() const = 0;
+    virtual double getRangoMin() const = 0;
+    virtual double getRangoMax() const = 0;
+};
+
+// Adaptador con borrado de tipo: expone un sensor estatico como Sensor
+// No es dueno del sensor adaptado.
+template <typename S>
+class AdaptadorSensor : public Sensor {
+private:
+    S* sensor;
+
+public:
+    explicit AdaptadorSensor(S* _sensor) : sensor(_sensor) {}
+
+    double leer() override { return sensor->leer(); }
+    EstadoLectura evaluarEstado() const override { return sensor->evaluarEstado(); }
+    void sembrar(uint64_t semilla) override { sensor->sembrar(semilla); }
+    void setReloj(const Reloj* reloj) override { sensor->setReloj(reloj); }
+
+    const std::string& getID() const override { return sensor->getID(); }
+    uint16_t getIdInterno() const override { return sensor->getIdInterno(); }
+    std::string getTipo() const override { return sensor->getTipo(); }
+    std::string getUnidad() const override { return sensor->getUnidad(); }
+    double getValorActual() const override { return sensor->getValorActual(); }
+    double getRangoMin() const override { return sensor->getRangoMin(); }
+    double getRangoMax() const override { return sensor->getRangoMax(); }
 };
 
+template <typename S>
+Sensor* adaptarSensor(S* sensor) {
+    return new AdaptadorSensor<S>(sensor);
+}
+
 #endif
@@ -4,22 +4,60 @@
 #include "Invernadero.hpp"
 #include <thread>
 #include <chrono>
+#include <atomic>
 
 // Clase para simulaci�n acelerada
+// El ciclo de control puede correr en su propio hilo; la interfaz solo debe
+// comunicarse con el mediante Invernadero::enviarComando mientras tanto.
 class Simulador {
 private:
     Invernadero* invernadero;
-    int ciclosPorSegundo;
+    int msPorCiclo;
+    std::thread hiloControl;
+    std::atomic<bool> ejecutando;
 
 public:
-    Simulador(Invernadero* inv, int cps = 10) : invernadero(inv), ciclosPorSegundo(cps) {}
+    Simulador(Invernadero* inv, int cps = 10) : invernadero(inv), msPorCiclo(1000 / cps), ejecutando(false) {}
+
+    // Pausa entre ciclos; solo tiene efecto en la siguiente simulacion
+    void setMsPorCiclo(int ms) {
+        if (!ejecutando.load()) msPorCiclo = ms;
+    }
+
+    int getMsPorCiclo() const { return msPorCiclo; }
+
+    ~Simulador() {
+        detener();
+    }
 
     void ejecutarSimulacion(int numCiclos) {
         for (int i = 0; i < numCiclos; ++i) {
             invernadero->ejecutarCicloControl();
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000 / ciclosPorSegundo));
+            std::this_thread::sleep_for(std::chrono::milliseconds(msPorCiclo));
         }
     }
+
+    // Lanzar numCiclos ciclos de control en un hilo aparte
+    void iniciarEnSegundoPlano(int numCiclos) {
+        if (ejecutando.load()) return;
+        if (hiloControl.joinable()) hiloControl.join();
+        ejecutando.store(true);
+        hiloControl = std::thread([this, numCiclos]() {
+            for (int i = 0; i < numCiclos && ejecutando.load(); ++i) {
+                invernadero->ejecutarCicloControl();
+                std::this_thread::sleep_for(std::chrono::milliseconds(msPorCiclo));
+            }
+            ejecutando.store(false);
+        });
+    }
+
+    // Pedir al hilo de control que termine y esperarlo
+    void detener() {
+        ejecutando.store(false);
+        if (hiloControl.joinable()) hiloControl.join();
+    }
+
+    bool estaEjecutando() const { return ejecutando.load(); }
 };
 
 #endif
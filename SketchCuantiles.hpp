@@ -0,0 +1,149 @@
+#ifndef SKETCH_CUANTILES_HPP
+#define SKETCH_CUANTILES_HPP
+
+#include "GeneradorAleatorio.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Sketch de cuantiles KLL (Karnin, Lang, Liberty) en flujo y combinable
+// Guarda los datos en niveles: un elemento del nivel h representa 2^h datos.
+// Cuando un nivel se llena se ordena y se promueve uno de cada dos elementos
+// (con desplazamiento aleatorio) al nivel siguiente. La memoria es O(k) sin
+// importar cuantos datos se agreguen y el error de rango es aproximadamente
+// 1.7/k (k = 200 -> ~0.85% del total de datos).
+class SketchCuantiles {
+private:
+    int k;
+    long cantidad;
+    int tamanoActual;   // elementos guardados en todos los niveles
+    int capacidadTotal; // suma de capacidades; al alcanzarla se compacta
+    std::vector<std::vector<double>> niveles;
+    GeneradorAleatorio generador;
+
+    // Capacidad del nivel h: k en el nivel mas alto, decreciendo 2/3 por nivel
+    int capacidad(size_t h) const {
+        size_t profundidad = niveles.size() - 1 - h;
+        return std::max(2, (int)std::ceil(k * std::pow(2.0 / 3.0, (double)profundidad)));
+    }
+
+    void recalcularCapacidad() {
+        capacidadTotal = 0;
+        for (size_t h = 0; h < niveles.size(); h++) {
+            capacidadTotal += capacidad(h);
+        }
+    }
+
+    // Compactar el nivel mas bajo que este lleno - O(k log k)
+    void compactar() {
+        for (size_t h = 0; h < niveles.size(); h++) {
+            if ((int)niveles[h].size() < capacidad(h)) continue;
+            if (h + 1 == niveles.size()) {
+                niveles.emplace_back();
+                recalcularCapacidad();
+            }
+            std::vector<double>& nivel = niveles[h];
+            std::vector<double>& superior = niveles[h + 1];
+
+            std::sort(nivel.begin(), nivel.end());
+            // Con tamano impar el ultimo elemento se queda en este nivel
+            bool sobra = nivel.size() % 2 == 1;
+            double sobrante = sobra ? nivel.back() : 0.0;
+            size_t pares = nivel.size() - (sobra ? 1 : 0);
+
+            for (size_t i = generador.entero(2); i < pares; i += 2) {
+                superior.push_back(nivel[i]);
+            }
+            tamanoActual -= (int)(pares / 2);
+            nivel.clear();
+            if (sobra) nivel.push_back(sobrante);
+            return;
+        }
+    }
+
+public:
+    // k controla el error; se puede derivar de un error objetivo con kParaError
+    explicit SketchCuantiles(int _k = 200, uint64_t semilla = 0x5eed)
+        : k(_k), cantidad(0), tamanoActual(0), generador(semilla) {
+        if (k < 8) {
+            throw std::invalid_argument("k debe ser al menos 8");
+        }
+        niveles.emplace_back();
+        recalcularCapacidad();
+    }
+
+    // k aproximado para un error de rango dado (p. ej. 0.01 -> 170)
+    static int kParaError(double error) {
+        if (error <= 0.0 || error >= 1.0) {
+            throw std::invalid_argument("Error fuera de rango");
+        }
+        return std::max(8, (int)std::ceil(1.7 / error));
+    }
+
+    // Agregar un dato - O(1) amortizado
+    void agregar(double x) {
+        niveles[0].push_back(x);
+        cantidad++;
+        tamanoActual++;
+        while (tamanoActual >= capacidadTotal) {
+            compactar();
+        }
+    }
+
+    // Incorporar otro sketch (p. ej. de otro sensor o de otro periodo) - O(k log k)
+    void combinar(const SketchCuantiles& otro) {
+        while (niveles.size() < otro.niveles.size()) {
+            niveles.emplace_back();
+        }
+        recalcularCapacidad();
+        for (size_t h = 0; h < otro.niveles.size(); h++) {
+            niveles[h].insert(niveles[h].end(), otro.niveles[h].begin(), otro.niveles[h].end());
+        }
+        cantidad += otro.cantidad;
+        tamanoActual += otro.tamanoActual;
+        while (tamanoActual >= capacidadTotal) {
+            compactar();
+        }
+    }
+
+    // Valor aproximado del cuantil q en [0, 1] - O(k log k)
+    double cuantil(double q) const {
+        if (cantidad == 0) return 0.0;
+        q = std::min(std::max(q, 0.0), 1.0);
+
+        std::vector<std::pair<double, long>> ponderados;
+        ponderados.reserve(tamanoActual);
+        for (size_t h = 0; h < niveles.size(); h++) {
+            long peso = 1L << h;
+            for (double x : niveles[h]) {
+                ponderados.push_back(std::make_pair(x, peso));
+            }
+        }
+        std::sort(ponderados.begin(), ponderados.end());
+
+        double objetivo = q * (cantidad - 1);
+        long acumulado = 0;
+        for (const auto& par : ponderados) {
+            acumulado += par.second;
+            if (acumulado > objetivo) return par.first;
+        }
+        return ponderados.back().first;
+    }
+
+    double mediana() const { return cuantil(0.5); }
+
+    long getCantidad() const { return cantidad; }
+    int getTamanoGuardado() const { return tamanoActual; }
+    int getK() const { return k; }
+
+    void limpiar() {
+        niveles.assign(1, std::vector<double>());
+        cantidad = 0;
+        tamanoActual = 0;
+        recalcularCapacidad();
+    }
+};
+
+#endif
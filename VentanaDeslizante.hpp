@@ -0,0 +1,177 @@
+#ifndef VENTANA_DESLIZANTE_HPP
+#define VENTANA_DESLIZANTE_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+
+// Agregados sobre ventanas deslizantes en O(1) amortizado por dato
+// La suma se mantiene incrementalmente y se recalcula cada tanto para no
+// acumular error de redondeo. Minimo y maximo usan deques monotonas: cada
+// muestra entra y sale a lo sumo una vez de cada una.
+class VentanaDeslizante {
+protected:
+    struct Muestra {
+        int64_t tiempoMs;
+        double valor;
+        unsigned long orden; // numero de llegada, identifica la muestra
+    };
+
+    std::deque<Muestra> muestras;
+    std::deque<Muestra> candidatosMin; // valores crecientes desde el frente
+    std::deque<Muestra> candidatosMax; // valores decrecientes desde el frente
+    double suma;
+    unsigned long llegadas;
+    long retirosDesdeRecalculo;
+
+    // Agregar al final - O(1) amortizado
+    void empujar(int64_t tiempoMs, double x) {
+        Muestra m = {tiempoMs, x, llegadas++};
+        muestras.push_back(m);
+        suma += x;
+        while (!candidatosMin.empty() && candidatosMin.back().valor >= x) candidatosMin.pop_back();
+        candidatosMin.push_back(m);
+        while (!candidatosMax.empty() && candidatosMax.back().valor <= x) candidatosMax.pop_back();
+        candidatosMax.push_back(m);
+    }
+
+    // Retirar la muestra mas antigua - O(1) amortizado
+    void retirar() {
+        const Muestra& vieja = muestras.front();
+        if (candidatosMin.front().orden == vieja.orden) candidatosMin.pop_front();
+        if (candidatosMax.front().orden == vieja.orden) candidatosMax.pop_front();
+        suma -= vieja.valor;
+        muestras.pop_front();
+
+        // Recalcular la suma despues de renovar la ventana completa
+        if (++retirosDesdeRecalculo > (long)muestras.size()) {
+            suma = 0.0;
+            for (const Muestra& m : muestras) suma += m.valor;
+            retirosDesdeRecalculo = 0;
+        }
+    }
+
+public:
+    VentanaDeslizante() : suma(0.0), llegadas(0), retirosDesdeRecalculo(0) {}
+
+    bool estaVacia() const { return muestras.empty(); }
+    int getTamano() const { return (int)muestras.size(); }
+
+    double promedio() const { return muestras.empty() ? 0.0 : suma / muestras.size(); }
+    double minimo() const { return candidatosMin.empty() ? 0.0 : candidatosMin.front().valor; }
+    double maximo() const { return candidatosMax.empty() ? 0.0 : candidatosMax.front().valor; }
+    double ultimo() const { return muestras.empty() ? 0.0 : muestras.back().valor; }
+
+    // Cambio por segundo entre la muestra mas antigua y la mas nueva - O(1)
+    double tasaCambio() const {
+        if (muestras.size() < 2) return 0.0;
+        int64_t dt = muestras.back().tiempoMs - muestras.front().tiempoMs;
+        if (dt <= 0) return 0.0;
+        return (muestras.back().valor - muestras.front().valor) * 1000.0 / dt;
+    }
+
+    void limpiar() {
+        muestras.clear();
+        candidatosMin.clear();
+        candidatosMax.clear();
+        suma = 0.0;
+        retirosDesdeRecalculo = 0;
+    }
+};
+
+// Ventana de las ultimas N muestras
+class VentanaConteo : public VentanaDeslizante {
+private:
+    int capacidad;
+
+public:
+    explicit VentanaConteo(int _capacidad) : capacidad(_capacidad) {
+        if (capacidad <= 0) {
+            throw std::invalid_argument("Capacidad debe ser positiva");
+        }
+    }
+
+    // Agregar una muestra y descartar la mas antigua si sobra - O(1) amortizado
+    void agregar(int64_t tiempoMs, double x) {
+        empujar(tiempoMs, x);
+        if ((int)muestras.size() > capacidad) retirar();
+    }
+
+    int getCapacidad() const { return capacidad; }
+};
+
+// Ventana de las muestras de los ultimos 'duracionMs' milisegundos
+// Los tiempos deben llegar en orden no decreciente.
+class VentanaTiempo : public VentanaDeslizante {
+private:
+    int64_t duracionMs;
+
+public:
+    explicit VentanaTiempo(int64_t _duracionMs) : duracionMs(_duracionMs) {
+        if (duracionMs <= 0) {
+            throw std::invalid_argument("Duracion debe ser positiva");
+        }
+    }
+
+    // Agregar una muestra y expirar las que quedaron fuera - O(1) amortizado
+    void agregar(int64_t tiempoMs, double x) {
+        empujar(tiempoMs, x);
+        expirar(tiempoMs);
+    }
+
+    // Expirar sin agregar (p. ej. si un sensor deja de reportar)
+    void expirar(int64_t ahoraMs) {
+        while (!muestras.empty() && muestras.front().tiempoMs <= ahoraMs - duracionMs) {
+            retirar();
+        }
+    }
+
+    int64_t getDuracionMs() const { return duracionMs; }
+};
+
+// Media movil exponencial: valor = alfa * x + (1 - alfa) * valor - O(1)
+class MediaExponencial {
+private:
+    double alfa;
+    double valor;
+    bool iniciada;
+
+public:
+    explicit MediaExponencial(double _alfa = 0.2) : alfa(_alfa), valor(0.0), iniciada(false) {
+        if (alfa <= 0.0 || alfa > 1.0) {
+            throw std::invalid_argument("Alfa fuera de rango");
+        }
+    }
+
+    // Alfa equivalente a una vida media de 'muestras' datos
+    static double alfaParaVidaMedia(double muestras) {
+        return 1.0 - std::pow(0.5, 1.0 / muestras);
+    }
+
+    void agregar(double x) {
+        valor = iniciada ? valor + alfa * (x - valor) : x;
+        iniciada = true;
+    }
+
+    double getValor() const { return valor; }
+    bool estaIniciada() const { return iniciada; }
+    void limpiar() { valor = 0.0; iniciada = false; }
+};
+
+// Senales suavizadas de un sensor que se actualizan con cada lectura
+struct SenalesVentana {
+    static const int64_t DURACION_MS = 5 * 60 * 1000;
+
+    VentanaTiempo ventana;
+    MediaExponencial media;
+
+    SenalesVentana() : ventana(DURACION_MS), media(0.2) {}
+
+    void agregar(int64_t tiempoMs, double x) {
+        ventana.agregar(tiempoMs, x);
+        media.agregar(x);
+    }
+};
+
+#endif